@@ -0,0 +1,37 @@
+#ifndef AABB_H
+#define AABB_H
+
+#include "game.h"
+
+#define AABB_MASK_BITS 32
+#define AABB_MASK_WORDS(count) (((count) + AABB_MASK_BITS - 1) / AABB_MASK_BITS)
+#define AABB_MASK_TEST(mask, index) (((mask)[(index) / AABB_MASK_BITS] >> ((index) % AABB_MASK_BITS)) & 1u)
+
+typedef struct {
+    float left, right;
+    float top, bottom;
+} AABB;
+
+typedef void (*AABBMaskKernel)(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+);
+
+void aabb_overlap_mask(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+);
+void aabb_overlap_mask_scalar(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+);
+const char* aabb_kernel_name(void);
+AABB sprite_aabb(const Sprite* sprite);
+
+#endif
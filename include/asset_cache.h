@@ -0,0 +1,28 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include "game.h"
+
+#define ASSET_CACHE_INITIAL_CAPACITY 32
+
+typedef struct {
+    char* path;
+    SDL_Texture* texture;
+    SDL_Rect source;
+    bool owns_texture;
+    int references;
+} TextureEntry;
+
+typedef struct {
+    Frames frames;
+    int references;
+} FramesEntry;
+
+SDL_Texture* asset_cache_acquire_texture(const char* path, SDL_Renderer* renderer, SDL_Rect* source);
+void asset_cache_release_texture(const char* path);
+bool asset_cache_insert_region(const char* path, SDL_Texture* texture, SDL_Rect source);
+Frames asset_cache_acquire_frames(const char** paths, size_t length, Uint32 delay, SDL_Renderer* renderer);
+void asset_cache_release_frames(Frames* frames);
+void asset_cache_cleanup(void);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include "game.h"
+
+#define ASSET_PACK_PATH "build/assets.pack"
+#define ASSET_PACK_MAGIC 0x4B504153u /* "SAPK" */
+#define ASSET_PACK_VERSION 2
+#define ASSET_PACK_PATH_LENGTH 128
+#define ASSET_PACK_ALIGNMENT 16
+#define ASSET_PACK_PIXEL_FORMAT SDL_PIXELFORMAT_ARGB8888
+
+typedef enum {
+    ASSET_PACK_IMAGE,
+    ASSET_PACK_SOUND,
+    ASSET_PACK_MUSIC
+} AssetPackKind;
+
+/*
+ * On-disk layout, written by tools/bake_assets.c:
+ *   AssetPackHeader | AssetPackEntry[entry_count] sorted by path | payloads
+ * Images are stored as pixel rows in ASSET_PACK_PIXEL_FORMAT, sounds as PCM in the
+ * mixer spec recorded in the header, music as the original compressed file. Every
+ * payload offset is aligned to ASSET_PACK_ALIGNMENT from the start of the file.
+ * Each entry records its source file's modification time and size when it was baked;
+ * an entry whose source has changed since is ignored and the source is loaded instead.
+ */
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 entry_count;
+    Uint32 audio_frequency;
+    Uint16 audio_format;
+    Uint16 audio_channels;
+    Uint32 pixel_format;
+} AssetPackHeader;
+
+typedef struct {
+    char path[ASSET_PACK_PATH_LENGTH];
+    Uint32 kind;
+    Sint32 width;
+    Sint32 height;
+    Sint32 pitch;
+    Uint64 offset;
+    Uint64 size;
+    Sint64 source_mtime;
+    Uint64 source_size;
+} AssetPackEntry;
+
+bool asset_pack_open(const char* path);
+size_t asset_pack_entry_count(void);
+const AssetPackEntry* asset_pack_find(const char* path, const void** data);
+SDL_Surface* asset_pack_load_surface(const char* path);
+Mix_Chunk* asset_pack_load_chunk(const char* path);
+Mix_Music* asset_pack_load_music(const char* path);
+void asset_pack_close(void);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+
+#include "game.h"
+
+#define ATLAS_MAX_SIZE 2048
+#define ATLAS_MAX_PAGES 8
+#define ATLAS_PADDING 1
+
+typedef struct {
+    SDL_Texture* texture;
+    int width, height;
+} AtlasPage;
+
+bool atlas_build(SDL_Renderer* renderer, const char** paths, size_t count);
+bool atlas_build_from_surfaces(SDL_Renderer* renderer, const char** paths, SDL_Surface** surfaces, size_t count);
+bool atlas_build_sprite_registry(SDL_Renderer* renderer);
+size_t atlas_page_count(void);
+void atlas_destroy(void);
+
+#endif
@@ -3,6 +3,11 @@
 
 #include "game.h"
 
+#define AUDIO_FREQUENCY 44100
+#define AUDIO_FORMAT MIX_DEFAULT_FORMAT
+#define AUDIO_CHANNELS 2
+#define AUDIO_CHUNK_SIZE 2048
+
 typedef enum {
     #define AUDIO_ENTRY(id, path, is_music) id,
     #include "audio_registry.def"
@@ -24,6 +29,7 @@ void play_sound(AudioID id);
 void play_music(AudioID id, bool loop);
 void stop_audio(void);
 void set_volume(int volume);
+void audio_begin_frame(void);
 AudioID get_collision_sound(SpriteType type);
 void audio_cleanup(void);
 
@@ -0,0 +1,40 @@
+#ifndef AUDIO_THREAD_H
+#define AUDIO_THREAD_H
+
+#include "game.h"
+
+#define AUDIO_COMMAND_CAPACITY 256
+
+typedef enum {
+    AUDIO_COMMAND_PLAY_SOUND,
+    AUDIO_COMMAND_PLAY_MUSIC,
+    AUDIO_COMMAND_STOP,
+    AUDIO_COMMAND_SET_VOLUME,
+    AUDIO_COMMAND_BEGIN_FRAME,
+    AUDIO_COMMAND_QUIT
+} AudioCommandType;
+
+typedef struct {
+    AudioCommandType type;
+    AudioID id;
+    int value;
+} AudioCommand;
+
+/*
+ * Single-producer, single-consumer ring between the game thread and the audio thread.
+ * head is only written by the game thread and tail only by the audio thread.
+ */
+typedef struct {
+    AudioCommand commands[AUDIO_COMMAND_CAPACITY];
+    atomic_size_t head;
+    atomic_size_t tail;
+    atomic_size_t dropped;
+} AudioCommandRing;
+
+bool audio_thread_start(void);
+void audio_thread_post(AudioCommand command);
+void audio_thread_stop(void);
+size_t audio_thread_dropped(void);
+void audio_execute_command(const AudioCommand* command);
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "game.h"
+
+#define BROADPHASE_CELL_SIZE 100
+#define BROADPHASE_COLUMNS ((WINDOW_WIDTH + BROADPHASE_CELL_SIZE - 1) / BROADPHASE_CELL_SIZE)
+#define BROADPHASE_ROWS ((WINDOW_HEIGHT + BROADPHASE_CELL_SIZE - 1) / BROADPHASE_CELL_SIZE)
+#define BROADPHASE_CELL_COUNT (BROADPHASE_COLUMNS * BROADPHASE_ROWS)
+#define BROADPHASE_INITIAL_CAPACITY 64
+
+typedef enum {
+    COLLISION_LAYER_NONE = 0,
+    COLLISION_LAYER_PLAYER = 1 << 0,
+    COLLISION_LAYER_ENEMY = 1 << 1,
+    COLLISION_LAYER_PICKUP = 1 << 2,
+    COLLISION_LAYER_PROJECTILE = 1 << 3,
+} CollisionLayer;
+
+typedef struct {
+    Uint32 a, b;
+} BroadphasePair;
+
+typedef struct {
+    Uint16 min_column, max_column;
+    Uint16 min_row, max_row;
+} BroadphaseCells;
+
+typedef void (*NarrowphaseCallback)(Uint32 id_a, Uint32 id_b, void* context);
+
+/*
+ * Uniform grid covering WINDOW_WIDTH x WINDOW_HEIGHT. Proxies are inserted every frame,
+ * binned into cells with a counting sort, and pairs sharing a cell whose layer masks
+ * accept each other become candidates for the narrowphase.
+ */
+typedef struct {
+    size_t length;
+    size_t capacity;
+    Uint32* ids;
+    AABB* bounds;
+    Uint32* layers;
+    Uint32* masks;
+    BroadphaseCells* cells;
+    Uint32 cell_start[BROADPHASE_CELL_COUNT + 1];
+    Uint32* cell_items;
+    size_t cell_items_capacity;
+    BroadphasePair* pairs;
+    size_t pairs_length;
+    size_t pairs_capacity;
+} Broadphase;
+
+void broadphase_init(Broadphase* broadphase, size_t capacity);
+void broadphase_free(Broadphase* broadphase);
+void broadphase_clear(Broadphase* broadphase);
+void broadphase_insert(Broadphase* broadphase, Uint32 id, SpriteType type, AABB bounds);
+void broadphase_insert_entities(Broadphase* broadphase, const EntityStore* store);
+void broadphase_build(Broadphase* broadphase);
+size_t broadphase_find_pairs(Broadphase* broadphase);
+size_t broadphase_narrowphase(const Broadphase* broadphase, NarrowphaseCallback callback, void* context);
+size_t broadphase_query(const Broadphase* broadphase, const AABB* box, Uint32 mask, Uint32* ids, size_t max_ids);
+Uint32 collision_layer_of(SpriteType type);
+Uint32 collision_mask_of(SpriteType type);
+
+#endif
@@ -9,6 +9,8 @@
 #define BUZZ_LIFE_DELTA -1
 #define BUZZ_RING_DELTA -2
 #define BUZZ_ZOOM_SCALE 1.2f
+#define BUZZ_POOL_CAPACITY 1
+#define BUZZ_SPAWN_INTERVAL 0
 
 Sprite create_buzz_enemy(SDL_Renderer* renderer);
 Sprite initialize_buzz(Frames frames);
@@ -0,0 +1,27 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include "game.h"
+
+/*
+ * Fixed-capacity spawner for one archetype. The archetype's frames are loaded once when
+ * the pool is created; spawning only claims a slot reserved in the EntityStore, so no
+ * allocation or texture loading happens mid-frame. Entities leaving the screen are
+ * released back to their pool and respawned by entity_pool_update().
+ */
+typedef struct EntityPool {
+    Sprite archetype;
+    EntityStore* store;
+    size_t capacity;
+    size_t live;
+    Uint32 spawn_interval;
+    Uint32 spawn_accumulator;
+} EntityPool;
+
+void entity_pool_init(EntityPool* pool, const Sprite* archetype, EntityStore* store, size_t capacity, Uint32 spawn_interval);
+size_t entity_pool_acquire(EntityPool* pool);
+void entity_pool_release(EntityPool* pool, size_t index);
+void entity_pool_update(EntityPool* pool, Uint32 delta_time);
+void entity_pool_free(EntityPool* pool);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef ENTITY_STORE_H
+#define ENTITY_STORE_H
+
+#include "game.h"
+
+#define ENTITY_STORE_INITIAL_CAPACITY 64
+#define ENTITY_NOT_FOUND ((size_t)-1)
+#define ENTITY_STORE_MIN_JOB_CHUNK 1024
+
+struct EntityPool;
+
+/*
+ * Structure-of-arrays storage for the non-player sprites (enemies, rings, lives).
+ * Each field lives in its own contiguous array indexed by entity, so the per-frame
+ * passes only stream through the fields they actually read. Frames and effects are
+ * shared through the archetype sprite the entity was spawned from.
+ * The per-frame passes split the arrays across the job system with parallel_for().
+ */
+typedef struct {
+    size_t length;
+    size_t capacity;
+    size_t reserved;
+    Rng* rng;
+    float* x;
+    float* y;
+    float* previous_x;
+    float* previous_y;
+    float* speed;
+    float* scale;
+    int* width;
+    int* height;
+    float* boundary_left;
+    float* boundary_right;
+    float* boundary_top;
+    float* boundary_bottom;
+    size_t* current_frame;
+    Uint32* animation_accumulator;
+    SpriteType* type;
+    CollisionState* collision_state;
+    Sprite** archetype;
+    struct EntityPool** pool;
+    Uint32* collision_mask;
+    Uint8* leaving;
+} EntityStore;
+
+/*
+ * Arguments shared by the chunks of one parallel pass over the store. `counted`
+ * gathers the per-chunk totals the pass reports once every chunk has finished.
+ */
+typedef struct {
+    EntityStore* store;
+    Uint32 delta_time;
+    float time_scale_factor;
+    AABB sonic_box;
+    atomic_uint counted;
+} EntityStoreJob;
+
+void entity_store_init(EntityStore* store, size_t capacity, Rng* rng);
+void entity_store_reserve(EntityStore* store, size_t capacity);
+void entity_store_free(EntityStore* store);
+size_t entity_store_add(EntityStore* store, Sprite* archetype);
+void entity_store_remove(EntityStore* store, size_t index);
+size_t entity_store_next_of_type(const EntityStore* store, SpriteType type, size_t start);
+void entity_store_animation(EntityStore* store, Uint32 delta_time);
+void entity_store_motion(EntityStore* store, Uint32 delta_time);
+void entity_store_save_previous_positions(EntityStore* store);
+void entity_store_update_boundaries(EntityStore* store, size_t index);
+void entity_store_update_collision_states(EntityStore* store, Sprite* sonic);
+void entity_store_handle_collisions(EntityStore* store, Sprite* sonic);
+void entity_store_snapshot(const EntityStore* store, RenderSnapshot* snapshot);
+
+#define ENTITY_STORE_FOR_EACH_OF_TYPE(store, sprite_type, index) \
+    for (size_t index = entity_store_next_of_type((store), (sprite_type), 0); \
+         index != ENTITY_NOT_FOUND; \
+         index = entity_store_next_of_type((store), (sprite_type), index + 1))
+
+#endif
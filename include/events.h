@@ -3,7 +3,11 @@
 
 #include "game.h"
 
-#define MAX_EVENTS 20
+#define EVENT_QUEUE_CAPACITY 256
+#define EVENT_SPILL_INITIAL_CAPACITY 64
+#define EVENT_BATCH_INITIAL_CAPACITY 64
+#define EVENT_COALESCE_MAX_OPEN 16
+#define EVENT_MAX_SUBSCRIBERS 8
 
 typedef enum {
     EVENT_LIFE_CHANGED,
@@ -16,13 +20,14 @@ typedef enum {
     EVENT_BACKGROUND_CHANGE,
     EVENT_SCREEN_SHAKE,
     EVENT_GAME_OVER,
+    EVENT_TYPE_COUNT
 } GameEventType;
 
 typedef struct {
     GameEventType type;
     Uint32 timestamp;
     union {
-        struct { Sprite* source; Sprite* target; } collision;
+        struct { Sprite* source; Sprite* target; int delta; } collision;
         struct { AudioID id; } sfx;
         struct { AudioID id;  bool loop; } music;
         struct { int index; } stage;
@@ -30,15 +35,60 @@ typedef struct {
 } GameEvent;
 
 typedef struct {
-    GameEvent events[MAX_EVENTS];
-    int head;
-    int tail;
+    atomic_size_t sequence;
+    GameEvent event;
+} EventSlot;
+
+typedef void (*EventBatchHandler)(const GameEvent* events, size_t length, void* context);
+
+typedef struct {
+    EventBatchHandler handler;
+    void* context;
+} EventSubscriber;
+
+typedef struct {
+    EventSubscriber subscribers[EVENT_MAX_SUBSCRIBERS];
+    size_t length;
+} EventSubscriberList;
+
+/*
+ * Bounded multi-producer, single-consumer ring. Any thread may queue events; only the
+ * thread running event_listener() dequeues. Each slot carries a sequence number that
+ * tells producers when it is free and the consumer when it is filled, so neither side
+ * takes a lock. When the ring is full, events go to a mutex-protected spill buffer that
+ * grows on demand, or are counted as dropped if spilling is disabled. The consumer
+ * drains into `batch` to coalesce a frame's events and buckets them by type into
+ * `sorted` before dispatching them.
+ */
+typedef struct {
+    EventSlot* slots;
+    size_t mask;
+    atomic_size_t head;
+    atomic_size_t tail;
+    bool spill_enabled;
+    atomic_bool spilling;
+    SDL_mutex* spill_lock;
+    GameEvent* spill;
+    size_t spill_read;
+    size_t spill_length;
+    size_t spill_capacity;
+    GameEvent* batch;
+    GameEvent* sorted;
+    size_t batch_capacity;
+    atomic_size_t high_water;
+    atomic_size_t spilled;
+    atomic_size_t dropped;
 } EventQueue;
 
 extern EventQueue global_queue;
 
 void initialize_event_queue(void);
+void event_queue_init(EventQueue* queue, size_t capacity, bool spill_enabled);
+void event_queue_free(EventQueue* queue);
 void event_listener(EventQueue* queue);
+size_t coalesce_events(GameEvent* events, size_t length);
+bool event_subscribe(GameEventType type, EventBatchHandler handler, void* context);
+void event_unsubscribe(GameEventType type, EventBatchHandler handler, void* context);
 void queue_event(EventQueue* queue, GameEvent event);
 GameEvent dequeue_event(EventQueue* queue);
 bool is_queue_empty(const EventQueue* queue);
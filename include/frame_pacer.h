@@ -0,0 +1,51 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include "game.h"
+
+#define FRAME_PACER_DEFAULT_RATE 60
+#define FRAME_PACER_SPIN_MS 2
+#define FRAME_PACER_HISTORY 256
+#define FRAME_PACER_BUCKET_US 100
+#define FRAME_PACER_BUCKETS 1000
+#define FRAME_PACER_VSYNC_TOLERANCE 0.75
+
+typedef enum {
+    FRAME_PACER_SLEEP,  // The pacer holds every frame until its deadline
+    FRAME_PACER_VSYNC   // Present already blocks on the display; the pacer only measures
+} FramePacerMode;
+
+/*
+ * Paces frames against absolute deadlines on the performance counter and keeps the
+ * last FRAME_PACER_HISTORY frame intervals, both raw (for the maximum) and as a
+ * histogram of FRAME_PACER_BUCKET_US buckets (for the percentiles).
+ */
+typedef struct {
+    FramePacerMode mode;
+    int rate;
+    Uint64 frequency;
+    Uint64 target_counts;
+    Uint64 spin_counts;
+    Uint64 deadline;
+    Uint64 last_frame;
+    Uint32 intervals[FRAME_PACER_HISTORY];
+    Uint16 interval_buckets[FRAME_PACER_HISTORY];
+    Uint32 buckets[FRAME_PACER_BUCKETS];
+    size_t interval_count;
+    size_t interval_next;
+    Uint64 frames;
+} FramePacer;
+
+typedef struct {
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+    size_t samples;
+} FramePacerStats;
+
+void frame_pacer_init(FramePacer* pacer, int rate, FramePacerMode mode);
+void frame_pacer_end_frame(FramePacer* pacer);
+void frame_pacer_stats(const FramePacer* pacer, FramePacerStats* stats);
+void frame_pacer_log(const FramePacer* pacer);
+
+#endif
@@ -6,23 +6,48 @@
 #include <SDL2/SDL_mixer.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include <time.h>
+
+#define WINDOW_WIDTH 1400
+#define WINDOW_HEIGHT 800
+#define EXIT_FAILURE 1
+#define EXIT_SUCCESS 0
+#define GAME_TITLE "Sonic Airborne Legacy"
+#define GAME_VERSION "1.0.0-alpha"
+#define STAGE_BACKGROUND_PATH "assets/backgrounds/stage3_bg.png"
+
 #include "utils.h"
+#include "profiler.h"
+#include "rng.h"
+#include "replay.h"
+#include "render_batch.h"
+#include "render_snapshot.h"
 #include "sprite.h"
+#include "pcm_cache.h"
+#include "asset_pack.h"
+#include "loader.h"
+#include "asset_cache.h"
+#include "atlas.h"
 #include "buzz.h"
 #include "sonic.h"
 #include "ring.h"
 #include "life.h"
 #include "game_over.h"
 #include "audio.h"
+#include "voice.h"
+#include "audio_thread.h"
 #include "events.h"
+#include "stats.h"
 #include "emitter.h"
-
-#define WINDOW_WIDTH 1400
-#define WINDOW_HEIGHT 800
-#define EXIT_FAILURE 1
-#define EXIT_SUCCESS 0
-#define GAME_TITLE "Sonic Airborne Legacy"
-#define GAME_VERSION "1.0.0-alpha"
+#include "aabb.h"
+#include "entity_store.h"
+#include "entity_pool.h"
+#include "broadphase.h"
+#include "jobs.h"
+#include "world.h"
+#include "simulation.h"
+#include "frame_pacer.h"
+#include "options.h"
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "game.h"
+
+#define JOBS_MAX_WORKERS 16
+#define JOBS_DEQUE_CAPACITY 1024
+#define JOBS_MAX_CHUNKS 256
+#define JOBS_CHUNKS_PER_WORKER 4
+#define JOBS_CHUNK_ALIGNMENT AABB_MASK_BITS
+#define JOBS_SPIN_ATTEMPTS 64
+
+typedef void (*JobFunction)(void* context, size_t begin, size_t end);
+
+typedef struct {
+    atomic_size_t remaining;
+} JobBatch;
+
+typedef struct {
+    JobFunction function;
+    void* context;
+    size_t begin;
+    size_t end;
+    JobBatch* batch;
+} Job;
+
+/*
+ * Chase-Lev work-stealing deque. The owning thread pushes and takes at the bottom;
+ * other threads steal from the top. Only the last remaining job is contended.
+ */
+typedef struct {
+    _Atomic(Job*) jobs[JOBS_DEQUE_CAPACITY];
+    atomic_llong top;
+    atomic_llong bottom;
+} JobDeque;
+
+bool jobs_start(int workers);
+void jobs_stop(void);
+int jobs_worker_count(void);
+void parallel_for(size_t count, size_t min_chunk, JobFunction function, void* context);
+
+#endif
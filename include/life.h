@@ -8,6 +8,8 @@
 #define LIFE_CURRENT_FRAME 1
 #define LIFE_DELTA 1
 #define LIFE_ZOOM_SCALE 0.5f
+#define LIFE_POOL_CAPACITY 1
+#define LIFE_SPAWN_INTERVAL 15000
 
 Sprite create_life(SDL_Renderer* renderer);
 Sprite initialize_life(Frames frames);
@@ -0,0 +1,30 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "game.h"
+
+#define LOADER_MAX_WORKERS 8
+
+typedef enum {
+    LOADER_IMAGE,
+    LOADER_SOUND,
+    LOADER_MUSIC
+} LoaderKind;
+
+typedef struct {
+    const char* path;
+    LoaderKind kind;
+    SDL_Surface* surface;
+    Mix_Chunk* chunk;
+    Mix_Music* music;
+} LoaderJob;
+
+void loader_start(void);
+double loader_wait(void);
+int loader_worker_count(void);
+SDL_Surface* loader_take_surface(const char* path);
+Mix_Chunk* loader_take_chunk(const char* path);
+Mix_Music* loader_take_music(const char* path);
+void loader_cleanup(void);
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef OPTIONS_H
+#define OPTIONS_H
+
+#include "game.h"
+
+typedef struct {
+    bool headless;
+    Uint32 headless_ticks;
+    bool has_seed;
+    Uint64 seed;
+    const char* record_path;
+    const char* replay_path;
+} GameOptions;
+
+bool options_parse(int argc, char* argv[], GameOptions* options);
+void options_print_usage(const char* program);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef PCM_CACHE_H
+#define PCM_CACHE_H
+
+#include "game.h"
+
+#define PCM_CACHE_DIRECTORY "build/pcm_cache"
+#define PCM_CACHE_MAGIC 0x4D435053u /* "SPCM" */
+#define PCM_CACHE_VERSION 1
+#define PCM_CACHE_PATH_LENGTH 128
+
+/*
+ * One cache file per sound, named after a hash of its source path and holding
+ * PcmCacheHeader followed by the PCM samples. A file is only used when the source
+ * path, modification time and size and the mixer spec all match its header.
+ */
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Sint64 source_mtime;
+    Uint64 source_size;
+    Uint32 frequency;
+    Uint16 format;
+    Uint16 channels;
+    Uint64 data_size;
+    char path[PCM_CACHE_PATH_LENGTH];
+} PcmCacheHeader;
+
+typedef struct {
+    void* data;
+    size_t size;
+} PcmCacheMapping;
+
+Mix_Chunk* pcm_cache_load_chunk(const char* path);
+void pcm_cache_cleanup(void);
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "game.h"
+
+#define PROFILER_RING_CAPACITY 65536
+#define PROFILER_MAX_THREADS 16
+#define PROFILER_MAX_PHASES 32
+#define PROFILER_HISTORY 256
+#define PROFILER_TRACE_PATH "build/trace.json"
+
+/*
+ * Scoped timers on the performance counter. Every thread records into its own ring of
+ * the last PROFILER_RING_CAPACITY samples, so recording never takes a lock. The main
+ * thread folds its samples into per-phase, per-frame totals at PROFILE_FRAME_END()
+ * for the p50/p99 summary; all rings are exported as a Chrome trace
+ * (chrome://tracing, Perfetto) at exit.
+ *
+ * Build with -DENABLE_PROFILER (make profile) to turn it on; otherwise every PROFILE_*
+ * macro compiles to nothing.
+ */
+typedef struct {
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+    Uint32 frame;
+    Uint32 depth;
+} ProfileSample;
+
+typedef struct {
+    ProfileSample samples[PROFILER_RING_CAPACITY];
+    atomic_size_t head;
+    size_t frame_start;
+    const char* name;
+    Uint32 id;
+    Uint32 depth;
+} ProfileThread;
+
+typedef struct {
+    const char* name;
+    Uint64 frame_counts;
+    bool seen;
+    float window_ms[PROFILER_HISTORY];
+    size_t length;
+    size_t next;
+} ProfilePhase;
+
+typedef struct {
+    const char* name;
+    Uint64 start;
+} ProfileScope;
+
+ProfileScope profile_scope_begin(const char* name);
+void profile_scope_end(ProfileScope* scope);
+void profile_thread_name(const char* name);
+void profile_frame_end(void);
+void profile_report(const char* trace_path);
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ENABLE_PROFILER
+#define PROFILE_SCOPE(name) \
+    ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__) __attribute__((cleanup(profile_scope_end))) = profile_scope_begin(name)
+#define PROFILE_THREAD(name) profile_thread_name(name)
+#define PROFILE_FRAME_END() profile_frame_end()
+#define PROFILE_REPORT(trace_path) profile_report(trace_path)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#define PROFILE_REPORT(trace_path) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef RENDER_BATCH_H
+#define RENDER_BATCH_H
+
+#include "game.h"
+
+#define RENDER_BATCH_INITIAL_CAPACITY 256
+
+typedef enum {
+    RENDER_LAYER_BACKGROUND,
+    RENDER_LAYER_PLAYER,
+    RENDER_LAYER_ENTITIES,
+    RENDER_LAYER_OVERLAY,
+} RenderLayer;
+
+typedef struct {
+    SDL_Texture* texture;
+    SDL_Rect source;
+    SDL_FRect destination;
+    RenderLayer layer;
+    Uint32 sequence;
+} RenderQuad;
+
+/*
+ * Per-frame draw list. Sprites submit textured quads while the frame is built; the
+ * flush sorts them by layer then texture and draws every run of quads sharing a
+ * texture with a single SDL_RenderGeometry call.
+ */
+typedef struct {
+    RenderQuad* quads;
+    size_t length;
+    size_t capacity;
+    SDL_Vertex* vertices;
+    int* indices;
+    size_t geometry_capacity;
+    size_t draw_calls;
+} RenderBatch;
+
+void render_batch_init(RenderBatch* batch, size_t capacity);
+void render_batch_free(RenderBatch* batch);
+void render_batch_submit(RenderBatch* batch, SDL_Texture* texture, const SDL_Rect* source, const SDL_FRect* destination, RenderLayer layer);
+size_t render_batch_flush(RenderBatch* batch, SDL_Renderer* renderer);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include "game.h"
+
+#define RENDER_SNAPSHOT_SLOTS 3
+#define RENDER_SNAPSHOT_INITIAL_CAPACITY 256
+#define RENDER_SNAPSHOT_FRESH 4
+
+typedef struct {
+    SDL_Texture* texture;
+    const SDL_Rect* source;
+    float previous_x;
+    float previous_y;
+    float x;
+    float y;
+    int width;
+    int height;
+    RenderLayer layer;
+} RenderSnapshotItem;
+
+/*
+ * What the simulation hands to the renderer after a tick: one item per visible sprite,
+ * with the frame to draw, its scaled size and its positions at the last two ticks.
+ * Source rectangles point into the sprites' frames, which outlive every snapshot.
+ * tick_counter is the performance counter value at which the tick was due, which the
+ * renderer measures its interpolation from.
+ */
+typedef struct {
+    RenderSnapshotItem* items;
+    size_t length;
+    size_t capacity;
+    Uint32 tick;
+    Uint64 tick_counter;
+} RenderSnapshot;
+
+/*
+ * Triple buffer between the simulation and the renderer. The simulation always has a
+ * slot of its own to write, the renderer always has one to read, and the third holds
+ * the latest published snapshot; publishing and acquiring only swap slot indices, so
+ * neither side ever waits for the other. `ready` holds the index of the latest slot,
+ * plus RENDER_SNAPSHOT_FRESH until the renderer takes it.
+ */
+typedef struct {
+    RenderSnapshot slots[RENDER_SNAPSHOT_SLOTS];
+    atomic_int ready;
+    int writing;
+    int reading;
+} RenderSnapshotBuffer;
+
+void render_snapshot_buffer_init(RenderSnapshotBuffer* buffer);
+void render_snapshot_buffer_free(RenderSnapshotBuffer* buffer);
+RenderSnapshot* render_snapshot_begin(RenderSnapshotBuffer* buffer);
+void render_snapshot_add(RenderSnapshot* snapshot, RenderSnapshotItem item);
+void render_snapshot_publish(RenderSnapshotBuffer* buffer, Uint32 tick, Uint64 tick_counter);
+const RenderSnapshot* render_snapshot_acquire(RenderSnapshotBuffer* buffer);
+void render_snapshot_submit(const RenderSnapshot* snapshot, RenderBatch* batch, float alpha);
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game.h"
+
+#define REPLAY_MAGIC 0x50455253u  // "SREP"
+#define REPLAY_VERSION 1
+#define REPLAY_INITIAL_CAPACITY 256
+
+typedef enum {
+    INPUT_LEFT = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_UP = 1 << 2,
+    INPUT_DOWN = 1 << 3
+} InputButton;
+
+typedef Uint8 InputState;
+
+typedef enum {
+    REPLAY_OFF,
+    REPLAY_RECORD,
+    REPLAY_PLAYBACK
+} ReplayMode;
+
+/*
+ * Input is stored run-length encoded: one run per change of the held buttons, so a
+ * session costs a few bytes per key press rather than one per tick.
+ */
+typedef struct {
+    Uint32 ticks;
+    InputState input;
+} ReplayRun;
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint64 seed;
+    Uint32 tick_count;
+    Uint32 run_count;
+} ReplayHeader;
+
+typedef struct {
+    ReplayMode mode;
+    Uint64 seed;
+    ReplayRun* runs;
+    size_t length;
+    size_t capacity;
+    Uint32 tick_count;
+    size_t cursor;
+    Uint32 cursor_tick;
+} Replay;
+
+InputState input_read_keyboard(void);
+void replay_init(Replay* replay, ReplayMode mode, Uint64 seed);
+bool replay_load(Replay* replay, const char* path);
+bool replay_save(const Replay* replay, const char* path);
+bool replay_next_input(Replay* replay, InputState live, InputState* input);
+void replay_free(Replay* replay);
+
+#endif
@@ -8,6 +8,8 @@
 #define RING_CURRENT_FRAME 1
 #define RING_DELTA 1
 #define RING_ZOOM_SCALE 0.2f
+#define RING_POOL_CAPACITY 100
+#define RING_SPAWN_INTERVAL 250
 
 Sprite create_ring(SDL_Renderer* renderer);
 Sprite initialize_ring(Frames frames);
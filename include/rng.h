@@ -0,0 +1,18 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include "game.h"
+
+/*
+ * xoshiro128** generator. Each GameWorld owns one, so a session is fully determined
+ * by its seed and its input.
+ */
+typedef struct {
+    Uint32 state[4];
+} Rng;
+
+void rng_seed(Rng* rng, Uint64 seed);
+Uint32 rng_next(Rng* rng);
+Uint32 rng_below(Rng* rng, Uint32 bound);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "game.h"
+
+/*
+ * Runs the world's fixed ticks on a thread of its own and publishes a render snapshot
+ * after each batch of ticks, so simulating tick N+1 overlaps with drawing and
+ * presenting tick N on the main thread. The main thread only hands over the live
+ * input and reads back snapshots; everything else the ticks touch (the world, the
+ * event queue, the audio command ring) is used by the simulation thread alone while
+ * it runs.
+ */
+typedef struct {
+    GameWorld* world;
+    RenderSnapshotBuffer snapshots;
+    SDL_Thread* thread;
+    Uint64 tick_counts;
+    Uint64 last_counter;
+    Uint64 accumulator;
+    atomic_uchar input;
+    atomic_bool running;
+    atomic_bool finished;
+} Simulation;
+
+void simulation_init(Simulation* simulation, GameWorld* world);
+bool simulation_start(Simulation* simulation);
+void simulation_set_input(Simulation* simulation, InputState input);
+bool simulation_update(Simulation* simulation);
+bool simulation_finished(Simulation* simulation);
+float simulation_alpha(const Simulation* simulation, const RenderSnapshot* snapshot);
+void simulation_stop(Simulation* simulation);
+void simulation_free(Simulation* simulation);
+
+#endif
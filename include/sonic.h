@@ -13,10 +13,10 @@
 
 Sprite create_sonic(SDL_Renderer* renderer);
 Sprite initialize_sonic(Frames frames);
-void sonic_motion(Sprite *sonic, Uint32 delta_time);
-void watch_player_interactions(Sprite *sonic, const Uint8 *keystates);
-void apply_hover_effect(Sprite *sonic);
-bool is_arrow_pressed(const Uint8 *keystates);
+void sonic_motion(Sprite *sonic, InputState input, Uint32 delta_time);
+void watch_player_interactions(Sprite *sonic, InputState input, Uint32 delta_time);
+void apply_hover_effect(Sprite *sonic, Uint32 delta_time);
+bool is_arrow_pressed(InputState input);
 void apply_friction(Sprite *sonic, float time_scale_factor); 
 void update_position(Sprite *sonic, float time_scale_factor);
 void check_boundary(Sprite *sonic);
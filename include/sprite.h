@@ -4,7 +4,9 @@
 #include "game.h"
 
 #define NORMALIZATION_FACTOR 16.0f
-#define TARGET_FRAME_TIME 16
+#define SIMULATION_TICK_MS 16
+#define MAX_TICKS_PER_FRAME 5
+#define SPRITE_HOT_ALIGNMENT 64
 
 typedef struct Frames {
     const char** paths;
@@ -13,6 +15,7 @@ typedef struct Frames {
     SDL_Texture** texture;
     int* widths;
     int* heights;
+    SDL_Rect* sources;
 } Frames;
 
 typedef enum {
@@ -47,31 +50,63 @@ typedef struct {
     int16_t ring_delta;
 } Effects;
 
-
-typedef struct Sprite {
-    float x, y, target_y;
-    int width, height;
-    int life, rings;
-    float scale, speed;
+/*
+ * Components only the player uses.
+ */
+typedef struct {
     float velocity_x, velocity_y;
     float acceleration, friction;
     float hover_amplitude, hover_frequency;
+    Uint32 hover_elapsed;
+} PlayerPhysics;
+
+typedef struct {
+    int life, rings;
+} PlayerStats;
+
+/*
+ * Cold half of a sprite: the asset references and collision effects, plus the
+ * player-only components. Copies of a sprite (e.g. an archetype's) share one record,
+ * owned by the sprite it was created for.
+ */
+typedef struct SpriteComponents {
+    Frames frames;
+    Effects effects;
+    PlayerPhysics physics;
+    PlayerStats stats;
+} SpriteComponents;
+
+/*
+ * Hot half of a sprite: exactly what the animation, motion, collision and render
+ * passes read every tick, in one cache line. `type` and `collision_state` hold a
+ * SpriteType and a CollisionState in a byte each.
+ */
+typedef struct Sprite {
+    _Alignas(SPRITE_HOT_ALIGNMENT) float x;
+    float y;
+    float previous_x, previous_y;
+    float scale, speed;
     float boundary_left, boundary_right;
     float boundary_top, boundary_bottom;
-    size_t current_frame;
-    Uint32 hover_start_time;
+    int width, height;
     Uint32 animation_accumulator;
-    Frames frames;
-    SpriteType type;
-    CollisionState collision_state;
-    Effects effects;
+    Uint16 current_frame;
+    Uint8 type;
+    Uint8 collision_state;
+    SpriteComponents* components;
 } Sprite;
 
+_Static_assert(sizeof(Sprite) == SPRITE_HOT_ALIGNMENT, "Sprite must fit one cache line");
+
 void load_texture(Frames* frames, SDL_Renderer* renderer);
+SpriteComponents* create_sprite_components(Frames frames);
 void sprite_animation(Sprite *sprite, Uint32 delta_time);
-void sprite_motion(Sprite *sprite, Uint32 delta_time);
+void sprite_motion(Sprite *sprite, Rng* rng, Uint32 delta_time);
 void sprite_render(Sprite *sprite, SDL_Renderer* renderer);
-int get_random_y_position(const Sprite *sprite);
+void sprite_snapshot(const Sprite *sprite, RenderSnapshot* snapshot, RenderLayer layer);
+void sprite_save_previous_position(Sprite *sprite);
+int get_random_y_position(Rng* rng, const Sprite *sprite);
+int get_random_y_for_size(Rng* rng, int height, float scale);
 float get_vertical_center_offset(const Sprite* sprite);
 void free_sprite_frames(Sprite *sprite);
 float get_time_scale_factor(Uint32 delta_time);
@@ -0,0 +1,51 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include "game.h"
+
+#define STATS_GRAPH_LENGTH 120
+#define STATS_GRAPH_HEIGHT 50
+#define STATS_GRAPH_MAX_MS 50.0f
+#define STATS_FONT_SCALE 2
+#define STATS_MAX_RECTS 4096
+
+typedef enum {
+    #define STAT_ENTRY(id, label) id,
+    #include "stats_registry.def"
+    #undef STAT_ENTRY
+    STAT_COUNT
+} StatCounter;
+
+/*
+ * One frame's worth of engine counters. Counters may be bumped from any thread (the
+ * audio thread starts voices, any thread may queue events), so they are relaxed
+ * atomics; hot loops add their totals once per pass rather than once per item.
+ */
+typedef struct {
+    atomic_uint counters[STAT_COUNT];
+    atomic_uint events_queued[EVENT_TYPE_COUNT];
+    atomic_uint events_dropped[EVENT_TYPE_COUNT];
+    atomic_uint events_dispatched[EVENT_TYPE_COUNT];
+} FrameStats;
+
+/*
+ * Plain copy of a finished frame's counters, as returned by stats_last_frame().
+ */
+typedef struct {
+    unsigned counters[STAT_COUNT];
+    unsigned events_queued[EVENT_TYPE_COUNT];
+    unsigned events_dropped[EVENT_TYPE_COUNT];
+    unsigned events_dispatched[EVENT_TYPE_COUNT];
+    float frame_ms;
+} FrameStatsSnapshot;
+
+void stats_add(StatCounter counter, unsigned amount);
+void stats_event_queued(GameEventType type);
+void stats_event_dropped(GameEventType type);
+void stats_events_dispatched(GameEventType type, unsigned amount);
+void stats_end_frame(void);
+const FrameStatsSnapshot* stats_last_frame(void);
+void stats_toggle_overlay(void);
+void stats_render_overlay(SDL_Renderer* renderer);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef VOICE_H
+#define VOICE_H
+
+#include "game.h"
+
+#define VOICE_CHANNELS 16
+#define VOICE_NONE -1
+
+typedef struct {
+    Uint8 priority;
+    Uint8 max_voices;
+} VoiceRule;
+
+typedef struct {
+    AudioID id;
+    Uint8 priority;
+    Uint32 started;
+    Uint32 frame;
+} Voice;
+
+void voice_initialization(void);
+void voice_begin_frame(void);
+int voice_play(AudioID id, Mix_Chunk* chunk);
+
+#endif
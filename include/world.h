@@ -0,0 +1,33 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "game.h"
+
+/*
+ * Everything the simulation advances. The world steps in fixed SIMULATION_TICK_MS
+ * ticks, independently of the display rate, and keeps each sprite's position from the
+ * previous tick so rendering can interpolate between the two. All randomness comes
+ * from the world's own Rng and all input goes through its Replay, so the same seed and
+ * input always replay the same session.
+ */
+typedef struct {
+    Rng rng;
+    Replay* replay;
+    Sprite sonic;
+    Sprite game_over;
+    EntityStore entities;
+    EntityPool buzz_pool;
+    Broadphase broadphase;
+    NarrowphaseCallback pair_handler;
+    void* pair_context;
+    Uint32 tick;
+} GameWorld;
+
+void world_init(GameWorld* world, SDL_Renderer* renderer, Replay* replay);
+void world_set_pair_handler(GameWorld* world, NarrowphaseCallback handler, void* context);
+bool world_tick(GameWorld* world, InputState live_input);
+void world_snapshot(const GameWorld* world, RenderSnapshot* snapshot);
+void world_free(GameWorld* world);
+double world_run_headless(GameWorld* world, Uint32 ticks);
+
+#endif
@@ -0,0 +1,178 @@
+#include "game.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AABB_HAS_X86_KERNELS 1
+#endif
+
+static _Atomic(AABBMaskKernel) selected_kernel = NULL;
+
+/**
+ * @brief Tests `box` against entities [start, count) one at a time and sets their mask bits.
+ *
+ * Uses the same strict comparisons as check_collision(), so touching edges do not collide.
+ * The mask words must already be cleared.
+ */
+static void overlap_mask_range(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t start, size_t count, Uint32* mask
+) {
+    for (size_t i = start; i < count; i++) {
+        bool is_colliding =
+            box->left < right[i] &&
+            box->right > left[i] &&
+            box->top < bottom[i] &&
+            box->bottom > top[i];
+        mask[i / AABB_MASK_BITS] |= (Uint32)is_colliding << (i % AABB_MASK_BITS);
+    }
+}
+
+/**
+ * @brief Portable kernel: one entity per iteration.
+ *
+ * @param box Box tested against every entity (usually the player's boundaries).
+ * @param left, right, top, bottom Packed boundary arrays of `count` entities.
+ * @param count Number of entities to test.
+ * @param mask Output bitmask with AABB_MASK_WORDS(count) words; bit i is set when entity i overlaps.
+ */
+void aabb_overlap_mask_scalar(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+) {
+    memset(mask, 0, AABB_MASK_WORDS(count) * sizeof(Uint32));
+    overlap_mask_range(box, left, right, top, bottom, 0, count, mask);
+}
+
+#ifdef AABB_HAS_X86_KERNELS
+/**
+ * @brief SSE2 kernel: four entities per iteration, scalar tail.
+ */
+__attribute__((target("sse2")))
+static void aabb_overlap_mask_sse2(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+) {
+    memset(mask, 0, AABB_MASK_WORDS(count) * sizeof(Uint32));
+    const __m128 box_left = _mm_set1_ps(box->left);
+    const __m128 box_right = _mm_set1_ps(box->right);
+    const __m128 box_top = _mm_set1_ps(box->top);
+    const __m128 box_bottom = _mm_set1_ps(box->bottom);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 hits = _mm_and_ps(
+            _mm_and_ps(
+                _mm_cmplt_ps(box_left, _mm_loadu_ps(right + i)),
+                _mm_cmpgt_ps(box_right, _mm_loadu_ps(left + i))
+            ),
+            _mm_and_ps(
+                _mm_cmplt_ps(box_top, _mm_loadu_ps(bottom + i)),
+                _mm_cmpgt_ps(box_bottom, _mm_loadu_ps(top + i))
+            )
+        );
+        mask[i / AABB_MASK_BITS] |= (Uint32)_mm_movemask_ps(hits) << (i % AABB_MASK_BITS);
+    }
+    overlap_mask_range(box, left, right, top, bottom, i, count, mask);
+}
+
+/**
+ * @brief AVX2 kernel: eight entities per iteration, scalar tail.
+ */
+__attribute__((target("avx2")))
+static void aabb_overlap_mask_avx2(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+) {
+    memset(mask, 0, AABB_MASK_WORDS(count) * sizeof(Uint32));
+    const __m256 box_left = _mm256_set1_ps(box->left);
+    const __m256 box_right = _mm256_set1_ps(box->right);
+    const __m256 box_top = _mm256_set1_ps(box->top);
+    const __m256 box_bottom = _mm256_set1_ps(box->bottom);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 hits = _mm256_and_ps(
+            _mm256_and_ps(
+                _mm256_cmp_ps(box_left, _mm256_loadu_ps(right + i), _CMP_LT_OQ),
+                _mm256_cmp_ps(box_right, _mm256_loadu_ps(left + i), _CMP_GT_OQ)
+            ),
+            _mm256_and_ps(
+                _mm256_cmp_ps(box_top, _mm256_loadu_ps(bottom + i), _CMP_LT_OQ),
+                _mm256_cmp_ps(box_bottom, _mm256_loadu_ps(top + i), _CMP_GT_OQ)
+            )
+        );
+        mask[i / AABB_MASK_BITS] |= (Uint32)_mm256_movemask_ps(hits) << (i % AABB_MASK_BITS);
+    }
+    overlap_mask_range(box, left, right, top, bottom, i, count, mask);
+}
+#endif
+
+/**
+ * @brief Returns the widest kernel supported by the running CPU.
+ *
+ * The choice is made on first use and kept for the rest of the run. Job workers may
+ * race to make it; they all pick the same kernel, so the pointer only needs to be atomic.
+ */
+static AABBMaskKernel current_kernel(void) {
+    AABBMaskKernel kernel = atomic_load_explicit(&selected_kernel, memory_order_relaxed);
+    if (kernel) return kernel;
+    kernel = aabb_overlap_mask_scalar;
+#ifdef AABB_HAS_X86_KERNELS
+    if (SDL_HasAVX2()) kernel = aabb_overlap_mask_avx2;
+    else if (SDL_HasSSE2()) kernel = aabb_overlap_mask_sse2;
+#endif
+    atomic_store_explicit(&selected_kernel, kernel, memory_order_relaxed);
+    return kernel;
+}
+
+/**
+ * @brief Tests one box against a packed array of entity boundaries and returns a hit bitmask.
+ *
+ * Dispatches to the AVX2, SSE2 or scalar kernel, whichever the CPU supports. Mask
+ * alignment matches the kernels: AABB_MASK_BITS is a multiple of 8, so vector lanes
+ * never straddle two mask words.
+ *
+ * @param box Box tested against every entity (usually the player's boundaries).
+ * @param left, right, top, bottom Packed boundary arrays of `count` entities.
+ * @param count Number of entities to test.
+ * @param mask Output bitmask with AABB_MASK_WORDS(count) words; bit i is set when entity i overlaps.
+ */
+void aabb_overlap_mask(
+    const AABB* box,
+    const float* left, const float* right,
+    const float* top, const float* bottom,
+    size_t count, Uint32* mask
+) {
+    current_kernel()(box, left, right, top, bottom, count, mask);
+}
+
+/**
+ * @brief Returns the name of the kernel used by aabb_overlap_mask() ("avx2", "sse2" or "scalar").
+ */
+const char* aabb_kernel_name(void) {
+    const AABBMaskKernel kernel = current_kernel();
+#ifdef AABB_HAS_X86_KERNELS
+    if (kernel == aabb_overlap_mask_avx2) return "avx2";
+    if (kernel == aabb_overlap_mask_sse2) return "sse2";
+#endif
+    return "scalar";
+}
+
+/**
+ * @brief Builds an AABB from a sprite's precomputed boundaries.
+ *
+ * @param sprite Sprite whose boundaries were refreshed by update_sprite_boundaries().
+ * @return The sprite's bounding box.
+ */
+AABB sprite_aabb(const Sprite* sprite) {
+    return (AABB){
+        sprite->boundary_left, sprite->boundary_right,
+        sprite->boundary_top, sprite->boundary_bottom
+    };
+}
@@ -0,0 +1,225 @@
+#include "game.h"
+
+static TextureEntry* texture_entries = NULL;
+static size_t texture_entries_length = 0;
+static size_t texture_entries_capacity = 0;
+static FramesEntry* frames_entries = NULL;
+static size_t frames_entries_length = 0;
+static size_t frames_entries_capacity = 0;
+
+/**
+ * @brief Grows one of the cache's entry arrays when it is full.
+ */
+static void ensure_capacity(void** entries, size_t element_size, size_t length, size_t* capacity) {
+    if (length < *capacity) return;
+    size_t grown = *capacity ? *capacity * 2 : ASSET_CACHE_INITIAL_CAPACITY;
+    void* resized = realloc(*entries, element_size * grown);
+    if (!resized) {
+        fprintf(stderr, "Failed to allocate memory for the asset cache.\n");
+        exit(EXIT_FAILURE);
+    }
+    *entries = resized;
+    *capacity = grown;
+}
+
+/**
+ * @brief Finds a cached texture by path.
+ *
+ * @return The matching entry, or NULL when the path was never loaded.
+ */
+static TextureEntry* find_texture(const char* path) {
+    for (size_t i = 0; i < texture_entries_length; i++)
+        if (strcmp(texture_entries[i].path, path) == 0) return &texture_entries[i];
+    return NULL;
+}
+
+/**
+ * @brief Finds a cached frame set with exactly the same paths, in the same order.
+ *
+ * @return The matching entry, or NULL when no archetype loaded these frames yet.
+ */
+static FramesEntry* find_frames(const char** paths, size_t length) {
+    for (size_t i = 0; i < frames_entries_length; i++) {
+        const Frames* frames = &frames_entries[i].frames;
+        if (frames->length != length) continue;
+        bool same_paths = true;
+        for (size_t j = 0; j < length && same_paths; j++)
+            same_paths = strcmp(frames->paths[j], paths[j]) == 0;
+        if (same_paths) return &frames_entries[i];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the texture for an image path, decoding the file only the first time.
+ *
+ * The PNG is decoded once into a surface; its dimensions are read from that surface
+ * and the texture is created from it, instead of decoding again with IMG_LoadTexture.
+ * Surfaces already decoded by the startup loader or baked into the asset pack skip the
+ * decode. Images packed into an atlas resolve to the atlas page and their region inside it.
+ * Every call takes a reference that must be given back with asset_cache_release_texture().
+ *
+ * @param path Path of the image to load.
+ * @param renderer SDL_Renderer used to create the texture on a cache miss.
+ * @param source Optional output for the image's rectangle inside the returned texture.
+ * @return The shared texture, or NULL if the image could not be loaded.
+ */
+SDL_Texture* asset_cache_acquire_texture(const char* path, SDL_Renderer* renderer, SDL_Rect* source) {
+    TextureEntry* entry = find_texture(path);
+    if (!entry) {
+        SDL_Surface* surface = loader_take_surface(path);
+        if (!surface) {
+            printf("Failed to load %s: %s\n", path, IMG_GetError());
+            return NULL;
+        }
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+        if (!texture) {
+            printf("Texture creation failed: %s\n", SDL_GetError());
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
+        ensure_capacity((void**)&texture_entries, sizeof(*texture_entries),
+            texture_entries_length, &texture_entries_capacity);
+        entry = &texture_entries[texture_entries_length++];
+        *entry = (TextureEntry){ SDL_strdup(path), texture, { 0, 0, surface->w, surface->h }, true, 0 };
+        SDL_FreeSurface(surface);
+    }
+    entry->references++;
+    if (source) *source = entry->source;
+    return entry->texture;
+}
+
+/**
+ * @brief Drops one reference to a cached image and forgets it when none are left.
+ *
+ * The texture is destroyed with the entry unless it belongs to an atlas page.
+ *
+ * @param path Path previously passed to asset_cache_acquire_texture().
+ */
+void asset_cache_release_texture(const char* path) {
+    TextureEntry* entry = find_texture(path);
+    if (!entry || --entry->references > 0) return;
+    if (entry->owns_texture) SDL_DestroyTexture(entry->texture);
+    SDL_free(entry->path);
+    *entry = texture_entries[--texture_entries_length];
+}
+
+/**
+ * @brief Registers an image that lives inside a larger texture, such as an atlas page.
+ *
+ * The entry starts with one reference held by the caller, who keeps ownership of the
+ * texture and must release that reference before destroying it. Paths already cached
+ * are left untouched, and no reference is taken for them.
+ *
+ * @param path Path of the packed image.
+ * @param texture Texture containing the image.
+ * @param source Rectangle of the image inside `texture`.
+ * @return true if the region was inserted, false if the path was already cached.
+ */
+bool asset_cache_insert_region(const char* path, SDL_Texture* texture, SDL_Rect source) {
+    if (find_texture(path)) return false;
+    ensure_capacity((void**)&texture_entries, sizeof(*texture_entries),
+        texture_entries_length, &texture_entries_capacity);
+    texture_entries[texture_entries_length++] = (TextureEntry){ SDL_strdup(path), texture, source, false, 1 };
+    return true;
+}
+
+/**
+ * @brief Returns the animation frames for a list of image paths, shared by every caller.
+ *
+ * The first call for a given list allocates the texture/width/height arrays and loads
+ * each frame through the texture cache; later calls return the same arrays and take a
+ * reference. The paths are copied, so the caller's array may live on the stack.
+ *
+ * @param paths Paths of the frame images, in animation order.
+ * @param length Number of frames.
+ * @param delay Animation delay stored in the returned Frames.
+ * @param renderer SDL_Renderer used to create textures on a cache miss.
+ * @return A Frames structure sharing the cached arrays.
+ */
+Frames asset_cache_acquire_frames(const char** paths, size_t length, Uint32 delay, SDL_Renderer* renderer) {
+    FramesEntry* entry = find_frames(paths, length);
+    if (!entry) {
+        const char** owned_paths = malloc(sizeof(char*) * length);
+        Frames frames = {
+            owned_paths,
+            length,
+            delay,
+            malloc(sizeof(SDL_Texture*) * length),
+            malloc(sizeof(int) * length),
+            malloc(sizeof(int) * length),
+            malloc(sizeof(SDL_Rect) * length)
+        };
+        if (!owned_paths || !frames.texture || !frames.widths || !frames.heights || !frames.sources) {
+            fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
+            exit(EXIT_FAILURE);
+        }
+        for (size_t i = 0; i < length; i++) owned_paths[i] = SDL_strdup(paths[i]);
+        load_texture(&frames, renderer);
+        ensure_capacity((void**)&frames_entries, sizeof(*frames_entries),
+            frames_entries_length, &frames_entries_capacity);
+        entry = &frames_entries[frames_entries_length++];
+        *entry = (FramesEntry){ frames, 0 };
+    }
+    entry->references++;
+    Frames frames = entry->frames;
+    frames.delay = delay;
+    return frames;
+}
+
+/**
+ * @brief Drops one reference to a shared frame set and frees it when none are left.
+ *
+ * The frame textures are released to the texture cache and the Frames arrays are
+ * cleared so the caller cannot use them afterwards.
+ *
+ * @param frames Frames returned by asset_cache_acquire_frames().
+ */
+void asset_cache_release_frames(Frames* frames) {
+    for (size_t i = 0; i < frames_entries_length; i++) {
+        FramesEntry* entry = &frames_entries[i];
+        if (entry->frames.texture != frames->texture) continue;
+        if (--entry->references == 0) {
+            for (size_t j = 0; j < entry->frames.length; j++) {
+                asset_cache_release_texture(entry->frames.paths[j]);
+                SDL_free((char*)entry->frames.paths[j]);
+            }
+            free((void*)entry->frames.paths);
+            free(entry->frames.texture);
+            free(entry->frames.widths);
+            free(entry->frames.heights);
+            free(entry->frames.sources);
+            *entry = frames_entries[--frames_entries_length];
+        }
+        break;
+    }
+    *frames = (Frames){0};
+}
+
+/**
+ * @brief Destroys everything still cached, regardless of outstanding references.
+ *
+ * Atlas pages are left to atlas_destroy(). Must run before the renderer that
+ * created the textures is destroyed.
+ */
+void asset_cache_cleanup(void) {
+    for (size_t i = 0; i < frames_entries_length; i++) {
+        Frames* frames = &frames_entries[i].frames;
+        for (size_t j = 0; j < frames->length; j++) SDL_free((char*)frames->paths[j]);
+        free((void*)frames->paths);
+        free(frames->texture);
+        free(frames->widths);
+        free(frames->heights);
+        free(frames->sources);
+    }
+    for (size_t i = 0; i < texture_entries_length; i++) {
+        if (texture_entries[i].owns_texture) SDL_DestroyTexture(texture_entries[i].texture);
+        SDL_free(texture_entries[i].path);
+    }
+    free(frames_entries);
+    free(texture_entries);
+    frames_entries = NULL;
+    texture_entries = NULL;
+    frames_entries_length = frames_entries_capacity = 0;
+    texture_entries_length = texture_entries_capacity = 0;
+}
@@ -0,0 +1,192 @@
+#define _POSIX_C_SOURCE 200809L
+#include "game.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const Uint8* pack_data = NULL;
+static size_t pack_size = 0;
+static const AssetPackHeader* pack_header = NULL;
+static const AssetPackEntry* pack_entries = NULL;
+
+/**
+ * @brief Checks that the header and every entry of a freshly mapped pack are in bounds.
+ *
+ * Image entries must also describe pixel rows that fit in their payload, since the
+ * surfaces wrapping them read straight from the mapping.
+ */
+static bool validate_pack(const Uint8* data, size_t size) {
+    if (size < sizeof(AssetPackHeader)) return false;
+    const AssetPackHeader* header = (const AssetPackHeader*)data;
+    if (header->magic != ASSET_PACK_MAGIC || header->version != ASSET_PACK_VERSION) return false;
+    if (header->pixel_format != ASSET_PACK_PIXEL_FORMAT) return false;
+    const size_t table_end = sizeof(AssetPackHeader) + (size_t)header->entry_count * sizeof(AssetPackEntry);
+    if (table_end > size) return false;
+    const AssetPackEntry* entries = (const AssetPackEntry*)(data + sizeof(AssetPackHeader));
+    for (Uint32 i = 0; i < header->entry_count; i++) {
+        if (entries[i].path[ASSET_PACK_PATH_LENGTH - 1] != '\0') return false;
+        if (entries[i].offset < table_end || entries[i].offset > size || entries[i].size > size - entries[i].offset) return false;
+        if (entries[i].kind == ASSET_PACK_IMAGE) {
+            if (entries[i].width <= 0 || entries[i].height <= 0) return false;
+            if ((Sint64)entries[i].pitch < (Sint64)entries[i].width * 4) return false;
+            if ((Uint64)entries[i].pitch * (Uint64)entries[i].height > entries[i].size) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns true unless the entry's source file exists and was modified since it was baked.
+ *
+ * A pack shipped without its sources stays usable; a source edited after `make bake`
+ * is loaded from disk instead of its outdated baked copy.
+ */
+static bool entry_is_current(const AssetPackEntry* entry) {
+    struct stat status;
+    if (stat(entry->path, &status) != 0) return true;
+    if ((Sint64)status.st_mtime == entry->source_mtime && (Uint64)status.st_size == entry->source_size) return true;
+    printf("Asset pack entry for %s is outdated, loading the source (run make bake)\n", entry->path);
+    return false;
+}
+
+/**
+ * @brief Maps a baked asset pack so the loaders below can read straight from it.
+ *
+ * The file is mapped read-only and stays mapped until asset_pack_close(); textures are
+ * uploaded from the mapping and sound chunks play directly out of it. When the pack is
+ * missing or was baked by another version, every loader falls back to the source files.
+ * Entries whose source changed after baking fall back one by one (see asset_pack_find()).
+ *
+ * @param path Path of the pack written by the bake tool.
+ * @return true if the pack was mapped and is valid.
+ */
+bool asset_pack_open(const char* path) {
+    asset_pack_close();
+    const int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0) return false;
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size <= 0) {
+        close(descriptor);
+        return false;
+    }
+    const size_t size = (size_t)status.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) return false;
+    if (!validate_pack(mapping, size)) {
+        printf("Ignoring invalid or outdated asset pack %s\n", path);
+        munmap(mapping, size);
+        return false;
+    }
+    pack_data = mapping;
+    pack_size = size;
+    pack_header = mapping;
+    pack_entries = (const AssetPackEntry*)(pack_data + sizeof(AssetPackHeader));
+    return true;
+}
+
+/**
+ * @brief Number of assets in the open pack, or 0 when no pack is mapped.
+ */
+size_t asset_pack_entry_count(void) {
+    return pack_header ? pack_header->entry_count : 0;
+}
+
+/**
+ * @brief Looks up an asset by its source path. The entry table is sorted, so this is a binary search.
+ *
+ * @param path Source path the asset was baked from.
+ * @param data Optional output for the start of the asset's payload inside the mapping.
+ * @return The entry, or NULL if no pack is open, the path was not baked or its source
+ *         changed since it was baked.
+ */
+const AssetPackEntry* asset_pack_find(const char* path, const void** data) {
+    if (!pack_header) return NULL;
+    size_t low = 0, high = pack_header->entry_count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const int order = strcmp(pack_entries[middle].path, path);
+        if (order == 0) {
+            if (!entry_is_current(&pack_entries[middle])) return NULL;
+            if (data) *data = pack_data + pack_entries[middle].offset;
+            return &pack_entries[middle];
+        }
+        if (order < 0) low = middle + 1;
+        else high = middle;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the decoded image for a path, from the pack when possible.
+ *
+ * A packed image comes back as a surface wrapping the mapped pixels, so nothing is
+ * opened, decoded or copied; it must not be written to. Otherwise the file is decoded
+ * with IMG_Load. Either way the caller frees the surface with SDL_FreeSurface().
+ *
+ * @param path Path of the image.
+ * @return The surface, or NULL if the image could not be loaded.
+ */
+SDL_Surface* asset_pack_load_surface(const char* path) {
+    const void* pixels = NULL;
+    const AssetPackEntry* entry = asset_pack_find(path, &pixels);
+    if (entry && entry->kind == ASSET_PACK_IMAGE) {
+        return SDL_CreateRGBSurfaceWithFormatFrom(
+            (void*)pixels, entry->width, entry->height, 32, entry->pitch, ASSET_PACK_PIXEL_FORMAT
+        );
+    }
+    return IMG_Load(path);
+}
+
+/**
+ * @brief Returns a sound effect for a path, from the pack when possible.
+ *
+ * Packed PCM is only used when the mixer was opened with the spec it was baked for;
+ * the chunk then points into the mapping and Mix_FreeChunk() leaves the samples alone.
+ * Otherwise the sound comes from the decoded PCM cache.
+ *
+ * @param path Path of the sound file.
+ * @return The chunk, or NULL if the sound could not be loaded.
+ */
+Mix_Chunk* asset_pack_load_chunk(const char* path) {
+    const void* samples = NULL;
+    const AssetPackEntry* entry = asset_pack_find(path, &samples);
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (entry && entry->kind == ASSET_PACK_SOUND && Mix_QuerySpec(&frequency, &format, &channels)
+        && frequency == (int)pack_header->audio_frequency && format == pack_header->audio_format
+        && channels == (int)pack_header->audio_channels) {
+        return Mix_QuickLoad_RAW((Uint8*)samples, (Uint32)entry->size);
+    }
+    return pcm_cache_load_chunk(path);
+}
+
+/**
+ * @brief Returns a music track for a path, streaming it from the pack when possible.
+ *
+ * Music is baked as the original compressed file and decoded while it plays, reading
+ * from the mapping instead of the filesystem.
+ *
+ * @param path Path of the music file.
+ * @return The music, or NULL if it could not be loaded.
+ */
+Mix_Music* asset_pack_load_music(const char* path) {
+    const void* bytes = NULL;
+    const AssetPackEntry* entry = asset_pack_find(path, &bytes);
+    if (entry && entry->kind == ASSET_PACK_MUSIC) {
+        return Mix_LoadMUS_RW(SDL_RWFromConstMem(bytes, (int)entry->size), 1);
+    }
+    return Mix_LoadMUS(path);
+}
+
+/**
+ * @brief Unmaps the pack. Every chunk and music loaded from it must be freed first.
+ */
+void asset_pack_close(void) {
+    if (pack_data) munmap((void*)pack_data, pack_size);
+    pack_data = NULL;
+    pack_size = 0;
+    pack_header = NULL;
+    pack_entries = NULL;
+}
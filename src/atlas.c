@@ -0,0 +1,224 @@
+#include "game.h"
+
+static const char* sprite_registry_paths[] = {
+    #define SPRITE_ENTRY(path) path,
+    #include "sprite_registry.def"
+    #undef SPRITE_ENTRY
+};
+
+static AtlasPage atlas_pages[ATLAS_MAX_PAGES];
+static size_t atlas_pages_length = 0;
+static char** atlas_paths = NULL;
+static size_t atlas_paths_length = 0;
+
+typedef struct {
+    size_t index;
+    size_t page;
+    SDL_Rect rect;
+} AtlasPlacement;
+
+static const SDL_Surface** sort_surfaces = NULL;
+
+/**
+ * @brief qsort comparator ordering placements by decreasing image height, then width.
+ */
+static int compare_by_height(const void* a, const void* b) {
+    const SDL_Surface* surface_a = sort_surfaces[((const AtlasPlacement*)a)->index];
+    const SDL_Surface* surface_b = sort_surfaces[((const AtlasPlacement*)b)->index];
+    if (surface_a->h != surface_b->h) return surface_b->h - surface_a->h;
+    return surface_b->w - surface_a->w;
+}
+
+/**
+ * @brief Returns the page size to pack into, bounded by what the renderer can create.
+ */
+static int atlas_page_size(SDL_Renderer* renderer) {
+    SDL_RendererInfo info;
+    int size = ATLAS_MAX_SIZE;
+    if (SDL_GetRendererInfo(renderer, &info) == 0) {
+        if (info.max_texture_width > 0) size = MIN(size, info.max_texture_width);
+        if (info.max_texture_height > 0) size = MIN(size, info.max_texture_height);
+    }
+    return size;
+}
+
+/**
+ * @brief Places every image on shelves, tallest first, opening a new page when one fills up.
+ *
+ * @return Number of pages used, or 0 if an image does not fit on a page or too many pages are needed.
+ */
+static size_t pack_shelves(AtlasPlacement* placements, SDL_Surface** surfaces, size_t count, int page_size, int* page_heights) {
+    sort_surfaces = (const SDL_Surface**)surfaces;
+    qsort(placements, count, sizeof(*placements), compare_by_height);
+    sort_surfaces = NULL;
+    size_t page = 0;
+    int shelf_x = 0, shelf_y = 0, shelf_height = 0;
+    page_heights[0] = 0;
+    for (size_t i = 0; i < count; i++) {
+        const SDL_Surface* surface = surfaces[placements[i].index];
+        const int width = surface->w + ATLAS_PADDING;
+        const int height = surface->h + ATLAS_PADDING;
+        if (width > page_size || height > page_size) {
+            printf("Atlas: image too large for a %dx%d page (%dx%d)\n", page_size, page_size, surface->w, surface->h);
+            return 0;
+        }
+        if (shelf_x + width > page_size) {
+            shelf_y += shelf_height;
+            shelf_x = 0;
+            shelf_height = 0;
+        }
+        if (shelf_y + height > page_size) {
+            if (++page == ATLAS_MAX_PAGES) {
+                printf("Atlas: more than %d pages needed\n", ATLAS_MAX_PAGES);
+                return 0;
+            }
+            page_heights[page] = 0;
+            shelf_x = shelf_y = shelf_height = 0;
+        }
+        placements[i].page = page;
+        placements[i].rect = (SDL_Rect){ shelf_x, shelf_y, surface->w, surface->h };
+        shelf_x += width;
+        shelf_height = MAX(shelf_height, height);
+        page_heights[page] = MAX(page_heights[page], shelf_y + height);
+    }
+    return page + 1;
+}
+
+/**
+ * @brief Packs already decoded images into atlas pages and registers them in the asset cache.
+ *
+ * Images are placed with a shelf packer (tallest first) on pages no larger than
+ * ATLAS_MAX_SIZE, separated by ATLAS_PADDING transparent pixels so linear filtering does
+ * not bleed neighbours in. Each page is blitted in system memory and uploaded as a
+ * single texture. Afterwards asset_cache_acquire_texture() resolves every packed path to
+ * its page and source rectangle, so Frames built later draw from the atlas. The surfaces
+ * stay owned by the caller.
+ *
+ * @param renderer SDL_Renderer used to create the page textures.
+ * @param paths Paths of the images, used as cache keys.
+ * @param surfaces Decoded images, one per path.
+ * @param count Number of images.
+ * @return true if every image was packed, false otherwise (nothing is registered then).
+ */
+bool atlas_build_from_surfaces(SDL_Renderer* renderer, const char** paths, SDL_Surface** surfaces, size_t count) {
+    atlas_destroy();
+    AtlasPlacement* placements = malloc(sizeof(AtlasPlacement) * count);
+    if (!placements) {
+        fprintf(stderr, "Failed to allocate memory for atlas placements.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < count; i++) placements[i].index = i;
+
+    const int page_size = atlas_page_size(renderer);
+    int page_heights[ATLAS_MAX_PAGES];
+    size_t pages = count > 0 ? pack_shelves(placements, surfaces, count, page_size, page_heights) : 0;
+    if (pages == 0) {
+        free(placements);
+        return false;
+    }
+
+    for (size_t page = 0; page < pages; page++) {
+        SDL_Surface* canvas = SDL_CreateRGBSurfaceWithFormat(0, page_size, page_heights[page], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!canvas) {
+            printf("Atlas page creation failed: %s\n", SDL_GetError());
+            free(placements);
+            atlas_destroy();
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (placements[i].page != page) continue;
+            SDL_Surface* surface = surfaces[placements[i].index];
+            SDL_Rect destination = placements[i].rect;
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surface, NULL, canvas, &destination);
+        }
+        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, canvas);
+        SDL_FreeSurface(canvas);
+        if (!texture) {
+            printf("Atlas texture creation failed: %s\n", SDL_GetError());
+            free(placements);
+            atlas_destroy();
+            return false;
+        }
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        atlas_pages[atlas_pages_length++] = (AtlasPage){ texture, page_size, page_heights[page] };
+    }
+
+    atlas_paths = malloc(sizeof(char*) * count);
+    if (!atlas_paths) {
+        fprintf(stderr, "Failed to allocate memory for atlas paths.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        const AtlasPlacement* placement = &placements[i];
+        // Only the references the atlas actually took are released by atlas_destroy()
+        if (asset_cache_insert_region(paths[placement->index], atlas_pages[placement->page].texture, placement->rect))
+            atlas_paths[atlas_paths_length++] = SDL_strdup(paths[placement->index]);
+    }
+    free(placements);
+    return true;
+}
+
+/**
+ * @brief Decodes the images at `paths` and packs them into atlas pages.
+ *
+ * See atlas_build_from_surfaces().
+ *
+ * @param renderer SDL_Renderer used to create the page textures.
+ * @param paths Paths of the images to pack.
+ * @param count Number of images.
+ * @return true if every image was loaded and packed.
+ */
+bool atlas_build(SDL_Renderer* renderer, const char** paths, size_t count) {
+    SDL_Surface** surfaces = calloc(count, sizeof(SDL_Surface*));
+    if (!surfaces) {
+        fprintf(stderr, "Failed to allocate memory for atlas surfaces.\n");
+        exit(EXIT_FAILURE);
+    }
+    bool loaded = true;
+    for (size_t i = 0; i < count && loaded; i++) {
+        surfaces[i] = loader_take_surface(paths[i]);
+        if (!surfaces[i]) {
+            printf("Failed to load %s: %s\n", paths[i], IMG_GetError());
+            loaded = false;
+        }
+    }
+    bool built = loaded && atlas_build_from_surfaces(renderer, paths, surfaces, count);
+    for (size_t i = 0; i < count; i++) SDL_FreeSurface(surfaces[i]);
+    free(surfaces);
+    return built;
+}
+
+/**
+ * @brief Packs every image listed in sprite_registry.def.
+ *
+ * @param renderer SDL_Renderer used to create the page textures.
+ * @return true if the atlas was built.
+ */
+bool atlas_build_sprite_registry(SDL_Renderer* renderer) {
+    return atlas_build(renderer, sprite_registry_paths, SDL_arraysize(sprite_registry_paths));
+}
+
+/**
+ * @brief Returns the number of atlas pages currently built.
+ */
+size_t atlas_page_count(void) {
+    return atlas_pages_length;
+}
+
+/**
+ * @brief Releases the atlas's references in the asset cache and destroys its pages.
+ *
+ * Sprites still holding frames from the atlas must be freed first.
+ */
+void atlas_destroy(void) {
+    for (size_t i = 0; i < atlas_paths_length; i++) {
+        asset_cache_release_texture(atlas_paths[i]);
+        SDL_free(atlas_paths[i]);
+    }
+    free(atlas_paths);
+    atlas_paths = NULL;
+    atlas_paths_length = 0;
+    for (size_t i = 0; i < atlas_pages_length; i++) SDL_DestroyTexture(atlas_pages[i].texture);
+    atlas_pages_length = 0;
+}
@@ -1,32 +1,62 @@
 #include "game.h"
 
 static AudioAsset audio_registry[AUDIO_COUNT];
+static bool frame_has_sound = false;
 
 /**
  * @brief Initializes the audio system by loading all audio assets defined in the audio registry.
  *
  * This function reads the audio registry definition file (audio_registry.def) and loads each audio asset
  * into the audio registry array. The audio assets can be either music or sound effects.
+ * Assets already decoded by the startup loader are taken from it; the rest are loaded
+ * from the asset pack or the source files.
  *
  * @param void This function does not take any parameters.
  *
  * @return void This function does not return any value.
  */
 void audio_initialization(void) {
-    #define AUDIO_ENTRY(id, path, is_music) \
-        if(is_music) { \
-            audio_registry[id].music = Mix_LoadMUS(path); \
+    voice_initialization();
+    #define AUDIO_ENTRY(id, path, music_entry) \
+        audio_registry[id].is_music = music_entry; \
+        if(music_entry) { \
+            audio_registry[id].music = loader_take_music(path); \
         } else { \
-            audio_registry[id].sound = Mix_LoadWAV(path); \
+            audio_registry[id].sound = loader_take_chunk(path); \
         }
     #include "audio_registry.def"
     #undef AUDIO_ENTRY
+    audio_thread_start();
+}
+
+/**
+ * @brief Runs one audio command against SDL_mixer. Called on the audio thread.
+ *
+ * This is the only place SDL_mixer is driven from while the game runs: sound effects
+ * go through the voice manager, music, stop and volume map straight to Mix_* calls.
+ *
+ * @param command The command posted by play_sound(), play_music(), stop_audio(),
+ * set_volume() or audio_begin_frame().
+ *
+ * @return void This function does not return any value.
+ */
+void audio_execute_command(const AudioCommand* command) {
+    PROFILE_SCOPE("audio_command");
+    switch(command->type) {
+        case AUDIO_COMMAND_PLAY_SOUND: voice_play(command->id, audio_registry[command->id].sound); break;
+        case AUDIO_COMMAND_PLAY_MUSIC: Mix_PlayMusic(audio_registry[command->id].music, command->value ? -1 : 0); break;
+        case AUDIO_COMMAND_STOP: Mix_HaltChannel(-1); Mix_HaltMusic(); break;
+        case AUDIO_COMMAND_SET_VOLUME: Mix_Volume(-1, command->value); break;
+        case AUDIO_COMMAND_BEGIN_FRAME: voice_begin_frame(); break;
+        case AUDIO_COMMAND_QUIT: break;
+    }
 }
 
 /**
  * @brief Plays a sound effect from the audio registry.
  *
- * This function uses the SDL_mixer library to play a specific sound effect from the audio registry.
+ * This function posts a specific sound effect from the audio registry to the audio thread,
+ * whose voice manager picks the channel according to the effect's priority and concurrency limit.
  * The sound effect is identified by its AudioID, which corresponds to its position in the audio registry array.
  *
  * @param id The AudioID of the sound effect to be played.
@@ -34,13 +64,15 @@ void audio_initialization(void) {
  * @return void This function does not return any value.
  */
 void play_sound(AudioID id) {
-    Mix_PlayChannel(-1, audio_registry[id].sound, 0);
+    frame_has_sound = true;
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_PLAY_SOUND, id, 0 });
 }
 
 /**
  * @brief Plays a music track from the audio registry.
  *
- * This function uses the SDL_mixer library to play a specific music track from the audio registry.
+ * This function posts a specific music track from the audio registry to the audio thread, so
+ * opening and decoding the track never stalls the game thread.
  * The music track is identified by its AudioID, which corresponds to its position in the audio registry array.
  *
  * @param id The AudioID of the music track to be played.
@@ -49,13 +81,13 @@ void play_sound(AudioID id) {
  * @return void This function does not return any value.
  */
 void play_music(AudioID id, bool loop) {
-    Mix_PlayMusic(audio_registry[id].music, loop ? -1 : 0);
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_PLAY_MUSIC, id, loop });
 }
 
 /**
  * @brief Stops all currently playing audio channels and music tracks.
  *
- * This function uses the SDL_mixer library to halt all currently playing audio channels and music tracks.
+ * This function asks the audio thread to halt all currently playing audio channels and music tracks.
  * It effectively stops all sound effects and music from playing.
  *
  * @param void This function does not take any parameters.
@@ -63,14 +95,13 @@ void play_music(AudioID id, bool loop) {
  * @return void This function does not return any value.
  */
 void stop_audio(void) {
-    Mix_HaltChannel(-1);
-    Mix_HaltMusic();
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_STOP, 0, 0 });
 }
 
 /**
  * @brief Sets the volume of all currently playing audio channels and music tracks.
  *
- * This function uses the SDL_mixer library to set the volume of all currently playing audio channels and music tracks.
+ * This function asks the audio thread to set the volume of all currently playing audio channels and music tracks.
  * The volume is specified as an integer value between 0 (silent) and 128 (full volume).
  *
  * @param volume An integer value representing the desired volume level. Must be within the range [0, 128].
@@ -78,7 +109,22 @@ void stop_audio(void) {
  * @return void This function does not return any value.
  */
 void set_volume(int volume) {
-    Mix_Volume(-1, volume);
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_SET_VOLUME, 0, volume });
+}
+
+/**
+ * @brief Marks the start of a game frame for the voice manager's deduplication window.
+ *
+ * Posted like any other command, so the window opens on the audio thread in order
+ * with the sound effects of the previous and the next frame. Frames without sound
+ * effects post nothing, since back-to-back windows change nothing.
+ *
+ * @return void This function does not return any value.
+ */
+void audio_begin_frame(void) {
+    if (!frame_has_sound) return;
+    frame_has_sound = false;
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_BEGIN_FRAME, 0, 0 });
 }
 
 /**
@@ -109,17 +155,19 @@ AudioID get_collision_sound(SpriteType type) {
  * @brief Cleans up and frees all loaded audio assets.
  *
  * This function is responsible for freeing all loaded audio assets, both music and sound effects,
- * from the audio registry array. It first emits a stop_audio event to ensure that no audio is playing
- * before proceeding with the cleanup process. Then, it iterates through the audio registry array,
- * checking the type of each audio asset (music or sound effect) and freeing the corresponding SDL_mixer
- * resource. After freeing the resource, it sets the pointer to NULL to prevent any dangling pointers.
+ * from the audio registry array. It first stops all audio and joins the audio thread, after running
+ * every command still queued, so nothing else touches SDL_mixer during the cleanup. Then, it
+ * iterates through the audio registry array, checking the type of each audio asset (music or
+ * sound effect) and freeing the corresponding SDL_mixer resource. After freeing the resource,
+ * it sets the pointer to NULL to prevent any dangling pointers.
  *
  * @param void This function does not take any parameters.
  *
  * @return void This function does not return any value.
  */
 void audio_cleanup(void) {
-    emit_stop_audio();
+    stop_audio();
+    audio_thread_stop();
     for(int i = 0; i < AUDIO_COUNT; i++) {
         if(audio_registry[i].is_music) {
             if(audio_registry[i].music) {
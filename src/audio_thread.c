@@ -0,0 +1,104 @@
+#include "game.h"
+
+static AudioCommandRing audio_commands;
+static SDL_Thread* audio_thread = NULL;
+static SDL_sem* audio_wakeup = NULL;
+
+/**
+ * @brief Pops the next command. Audio thread only.
+ *
+ * @return false when the ring is empty.
+ */
+static bool pop_command(AudioCommand* command) {
+    const size_t tail = atomic_load_explicit(&audio_commands.tail, memory_order_relaxed);
+    if (tail == atomic_load_explicit(&audio_commands.head, memory_order_acquire)) return false;
+    *command = audio_commands.commands[tail & (AUDIO_COMMAND_CAPACITY - 1)];
+    atomic_store_explicit(&audio_commands.tail, tail + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Audio thread loop: sleeps until commands arrive and runs them in order.
+ */
+static int audio_thread_main(void* data) {
+    (void)data;
+    PROFILE_THREAD("audio");
+    for (;;) {
+        SDL_SemWait(audio_wakeup);
+        AudioCommand command;
+        while (pop_command(&command)) {
+            if (command.type == AUDIO_COMMAND_QUIT) return 0;
+            audio_execute_command(&command);
+        }
+    }
+}
+
+/**
+ * @brief Starts the thread that owns every SDL_mixer call while the game runs.
+ *
+ * Must run after audio_initialization() has loaded the registry. If the thread cannot
+ * be created, commands keep running on the caller's thread.
+ *
+ * @return true if the audio thread is running.
+ */
+bool audio_thread_start(void) {
+    atomic_init(&audio_commands.head, 0);
+    atomic_init(&audio_commands.tail, 0);
+    atomic_init(&audio_commands.dropped, 0);
+    audio_wakeup = SDL_CreateSemaphore(0);
+    if (audio_wakeup) audio_thread = SDL_CreateThread(audio_thread_main, "audio", NULL);
+    if (!audio_thread) {
+        printf("Audio thread unavailable, mixing commands run on the game thread: %s\n", SDL_GetError());
+        if (audio_wakeup) SDL_DestroySemaphore(audio_wakeup);
+        audio_wakeup = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hands a command to the audio thread without ever waiting on it. Game thread only.
+ *
+ * The command is copied into the ring and published with a release store; the audio
+ * thread is woken with a semaphore post. When the ring is full the command is dropped
+ * and counted rather than stalling the frame.
+ *
+ * @param command Command to run on the audio thread.
+ */
+void audio_thread_post(AudioCommand command) {
+    if (!audio_thread) {
+        if (command.type != AUDIO_COMMAND_QUIT) audio_execute_command(&command);
+        return;
+    }
+    const size_t head = atomic_load_explicit(&audio_commands.head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&audio_commands.tail, memory_order_acquire) == AUDIO_COMMAND_CAPACITY) {
+        atomic_fetch_add_explicit(&audio_commands.dropped, 1, memory_order_relaxed);
+        return;
+    }
+    audio_commands.commands[head & (AUDIO_COMMAND_CAPACITY - 1)] = command;
+    atomic_store_explicit(&audio_commands.head, head + 1, memory_order_release);
+    SDL_SemPost(audio_wakeup);
+}
+
+/**
+ * @brief Runs every queued command, then stops and joins the audio thread.
+ *
+ * A full ring is retried until the quit command fits, since shutdown may wait.
+ */
+void audio_thread_stop(void) {
+    if (!audio_thread) return;
+    const size_t head = atomic_load_explicit(&audio_commands.head, memory_order_relaxed);
+    while (head - atomic_load_explicit(&audio_commands.tail, memory_order_acquire) == AUDIO_COMMAND_CAPACITY) SDL_Delay(1);
+    audio_thread_post((AudioCommand){ AUDIO_COMMAND_QUIT, 0, 0 });
+    SDL_WaitThread(audio_thread, NULL);
+    SDL_DestroySemaphore(audio_wakeup);
+    audio_thread = NULL;
+    audio_wakeup = NULL;
+}
+
+/**
+ * @brief Number of commands dropped because the ring was full.
+ */
+size_t audio_thread_dropped(void) {
+    return atomic_load_explicit(&audio_commands.dropped, memory_order_relaxed);
+}
@@ -0,0 +1,317 @@
+#include "game.h"
+
+static const Uint32 type_layers[] = {
+    [PLAYER] = COLLISION_LAYER_PLAYER,
+    [BUZZ] = COLLISION_LAYER_ENEMY,
+    [BEE] = COLLISION_LAYER_ENEMY,
+    [BAT] = COLLISION_LAYER_ENEMY,
+    [FLAME] = COLLISION_LAYER_ENEMY,
+    [PARROT] = COLLISION_LAYER_ENEMY,
+    [RING] = COLLISION_LAYER_PICKUP,
+    [LIFE] = COLLISION_LAYER_PICKUP,
+    [GAME_OVER] = COLLISION_LAYER_NONE,
+};
+
+static const Uint32 type_masks[] = {
+    [PLAYER] = COLLISION_LAYER_ENEMY | COLLISION_LAYER_PICKUP,
+    [BUZZ] = COLLISION_LAYER_PLAYER | COLLISION_LAYER_PROJECTILE,
+    [BEE] = COLLISION_LAYER_PLAYER | COLLISION_LAYER_PROJECTILE,
+    [BAT] = COLLISION_LAYER_PLAYER | COLLISION_LAYER_PROJECTILE,
+    [FLAME] = COLLISION_LAYER_PLAYER | COLLISION_LAYER_PROJECTILE,
+    [PARROT] = COLLISION_LAYER_PLAYER | COLLISION_LAYER_PROJECTILE,
+    [RING] = COLLISION_LAYER_PLAYER,
+    [LIFE] = COLLISION_LAYER_PLAYER,
+    [GAME_OVER] = COLLISION_LAYER_NONE,
+};
+
+/**
+ * @brief Resizes one of the broadphase's growable arrays.
+ */
+static void resize_array(void** array, size_t element_size, size_t capacity) {
+    void* resized = realloc(*array, element_size * capacity);
+    if (!resized) {
+        fprintf(stderr, "Failed to allocate memory for Broadphase arrays.\n");
+        exit(EXIT_FAILURE);
+    }
+    *array = resized;
+}
+
+/**
+ * @brief Maps a coordinate to a grid line, clamping anything off-screen to the border cells.
+ *
+ * Anything left of or above the grid clamps to line 0, so truncating toward zero picks
+ * the same line as floorf() without the library call.
+ */
+static Uint16 grid_line(float coordinate, int lines) {
+    if (coordinate <= 0) return 0;
+    int line = (int)(coordinate / BROADPHASE_CELL_SIZE);
+    return (Uint16)MIN(line, lines - 1);
+}
+
+/**
+ * @brief Computes the range of cells covered by a box.
+ */
+static BroadphaseCells cells_of(const AABB* box) {
+    return (BroadphaseCells){
+        grid_line(box->left, BROADPHASE_COLUMNS), grid_line(box->right, BROADPHASE_COLUMNS),
+        grid_line(box->top, BROADPHASE_ROWS), grid_line(box->bottom, BROADPHASE_ROWS)
+    };
+}
+
+/**
+ * @brief Returns true when `cell` is the first (top-left) cell shared by two cell ranges.
+ *
+ * Two boxes can share many cells; reporting them only from the first shared one
+ * keeps each pair unique without a hash set.
+ */
+static bool is_first_shared_cell(const BroadphaseCells* a, const BroadphaseCells* b, int column, int row) {
+    return MAX(a->min_column, b->min_column) == column && MAX(a->min_row, b->min_row) == row;
+}
+
+/**
+ * @brief Same strict overlap test as check_collision().
+ */
+static bool boxes_overlap(const AABB* a, const AABB* b) {
+    return a->left < b->right && a->right > b->left && a->top < b->bottom && a->bottom > b->top;
+}
+
+/**
+ * @brief Returns the collision layer a sprite type belongs to.
+ *
+ * @param type The SpriteType to classify.
+ * @return One of the CollisionLayer bits, or COLLISION_LAYER_NONE.
+ */
+Uint32 collision_layer_of(SpriteType type) {
+    return type_layers[type];
+}
+
+/**
+ * @brief Returns the set of layers a sprite type wants to collide with.
+ *
+ * @param type The SpriteType to classify.
+ * @return A mask of CollisionLayer bits.
+ */
+Uint32 collision_mask_of(SpriteType type) {
+    return type_masks[type];
+}
+
+/**
+ * @brief Initializes an empty broadphase with room for `capacity` proxies.
+ *
+ * @param broadphase Pointer to the Broadphase to initialize.
+ * @param capacity Number of proxies to preallocate.
+ */
+void broadphase_init(Broadphase* broadphase, size_t capacity) {
+    *broadphase = (Broadphase){0};
+    capacity = capacity > 0 ? capacity : BROADPHASE_INITIAL_CAPACITY;
+    resize_array((void**)&broadphase->ids, sizeof(*broadphase->ids), capacity);
+    resize_array((void**)&broadphase->bounds, sizeof(*broadphase->bounds), capacity);
+    resize_array((void**)&broadphase->layers, sizeof(*broadphase->layers), capacity);
+    resize_array((void**)&broadphase->masks, sizeof(*broadphase->masks), capacity);
+    resize_array((void**)&broadphase->cells, sizeof(*broadphase->cells), capacity);
+    broadphase->capacity = capacity;
+}
+
+/**
+ * @brief Releases every array owned by the broadphase.
+ *
+ * @param broadphase Pointer to the Broadphase to free.
+ */
+void broadphase_free(Broadphase* broadphase) {
+    free(broadphase->ids);
+    free(broadphase->bounds);
+    free(broadphase->layers);
+    free(broadphase->masks);
+    free(broadphase->cells);
+    free(broadphase->cell_items);
+    free(broadphase->pairs);
+    *broadphase = (Broadphase){0};
+}
+
+/**
+ * @brief Removes every proxy and candidate pair, keeping the allocated memory.
+ *
+ * @param broadphase Pointer to the Broadphase to clear.
+ */
+void broadphase_clear(Broadphase* broadphase) {
+    broadphase->length = 0;
+    broadphase->pairs_length = 0;
+}
+
+/**
+ * @brief Adds one proxy to the broadphase.
+ *
+ * Its layer and mask come from the sprite type. Proxies of a type without a layer
+ * (e.g., GAME_OVER) are ignored.
+ *
+ * @param broadphase Pointer to the Broadphase.
+ * @param id Caller-defined identifier reported back in pairs and queries.
+ * @param type SpriteType used to pick the collision layer and mask.
+ * @param bounds Bounding box of the proxy.
+ */
+void broadphase_insert(Broadphase* broadphase, Uint32 id, SpriteType type, AABB bounds) {
+    if (collision_layer_of(type) == COLLISION_LAYER_NONE) return;
+    if (broadphase->length == broadphase->capacity) {
+        size_t capacity = broadphase->capacity * 2;
+        resize_array((void**)&broadphase->ids, sizeof(*broadphase->ids), capacity);
+        resize_array((void**)&broadphase->bounds, sizeof(*broadphase->bounds), capacity);
+        resize_array((void**)&broadphase->layers, sizeof(*broadphase->layers), capacity);
+        resize_array((void**)&broadphase->masks, sizeof(*broadphase->masks), capacity);
+        resize_array((void**)&broadphase->cells, sizeof(*broadphase->cells), capacity);
+        broadphase->capacity = capacity;
+    }
+    size_t index = broadphase->length++;
+    broadphase->ids[index] = id;
+    broadphase->bounds[index] = bounds;
+    broadphase->layers[index] = collision_layer_of(type);
+    broadphase->masks[index] = collision_mask_of(type);
+    broadphase->cells[index] = cells_of(&bounds);
+}
+
+/**
+ * @brief Adds every entity of an EntityStore, using the entity index as the proxy id.
+ *
+ * @param broadphase Pointer to the Broadphase.
+ * @param store Pointer to the EntityStore whose boundaries are up to date.
+ */
+void broadphase_insert_entities(Broadphase* broadphase, const EntityStore* store) {
+    for (size_t i = 0; i < store->length; i++) {
+        AABB bounds = {
+            store->boundary_left[i], store->boundary_right[i],
+            store->boundary_top[i], store->boundary_bottom[i]
+        };
+        broadphase_insert(broadphase, (Uint32)i, store->type[i], bounds);
+    }
+}
+
+/**
+ * @brief Bins every proxy into the grid cells it covers.
+ *
+ * A two-pass counting sort: count proxies per cell, turn the counts into start
+ * offsets, then scatter proxy indices. Proxies of one cell end up contiguous in
+ * `cell_items[cell_start[c] .. cell_start[c + 1]]`.
+ *
+ * @param broadphase Pointer to the Broadphase, after all proxies were inserted.
+ */
+void broadphase_build(Broadphase* broadphase) {
+    Uint32 cursor[BROADPHASE_CELL_COUNT] = {0};
+    size_t total = 0;
+    for (size_t i = 0; i < broadphase->length; i++) {
+        const BroadphaseCells* cells = &broadphase->cells[i];
+        for (int row = cells->min_row; row <= cells->max_row; row++)
+            for (int column = cells->min_column; column <= cells->max_column; column++)
+                cursor[row * BROADPHASE_COLUMNS + column]++;
+        total += (size_t)(cells->max_row - cells->min_row + 1) * (size_t)(cells->max_column - cells->min_column + 1);
+    }
+    if (total > broadphase->cell_items_capacity) {
+        resize_array((void**)&broadphase->cell_items, sizeof(*broadphase->cell_items), total);
+        broadphase->cell_items_capacity = total;
+    }
+    Uint32 start = 0;
+    for (int cell = 0; cell < BROADPHASE_CELL_COUNT; cell++) {
+        broadphase->cell_start[cell] = start;
+        start += cursor[cell];
+        cursor[cell] = broadphase->cell_start[cell];
+    }
+    broadphase->cell_start[BROADPHASE_CELL_COUNT] = start;
+    for (size_t i = 0; i < broadphase->length; i++) {
+        const BroadphaseCells* cells = &broadphase->cells[i];
+        for (int row = cells->min_row; row <= cells->max_row; row++)
+            for (int column = cells->min_column; column <= cells->max_column; column++)
+                broadphase->cell_items[cursor[row * BROADPHASE_COLUMNS + column]++] = (Uint32)i;
+    }
+}
+
+/**
+ * @brief Collects the candidate pairs: proxies sharing a cell whose layer masks accept each other.
+ *
+ * A pair is accepted when either side's mask contains the other side's layer. Each
+ * pair is reported once. The pairs hold proxy indices (use `ids[pair.a]` for the
+ * caller's identifiers) and are only coarse candidates; run broadphase_narrowphase()
+ * for exact overlaps.
+ *
+ * @param broadphase Pointer to the Broadphase, after broadphase_build().
+ * @return Number of candidate pairs stored in `broadphase->pairs`.
+ */
+size_t broadphase_find_pairs(Broadphase* broadphase) {
+    broadphase->pairs_length = 0;
+    for (int row = 0; row < BROADPHASE_ROWS; row++) {
+        for (int column = 0; column < BROADPHASE_COLUMNS; column++) {
+            const int cell = row * BROADPHASE_COLUMNS + column;
+            const Uint32 begin = broadphase->cell_start[cell];
+            const Uint32 end = broadphase->cell_start[cell + 1];
+            for (Uint32 i = begin; i < end; i++) {
+                const Uint32 a = broadphase->cell_items[i];
+                for (Uint32 j = i + 1; j < end; j++) {
+                    const Uint32 b = broadphase->cell_items[j];
+                    bool accepted = (broadphase->masks[a] & broadphase->layers[b]) ||
+                        (broadphase->masks[b] & broadphase->layers[a]);
+                    if (!accepted) continue;
+                    if (!is_first_shared_cell(&broadphase->cells[a], &broadphase->cells[b], column, row)) continue;
+                    if (broadphase->pairs_length == broadphase->pairs_capacity) {
+                        size_t capacity = broadphase->pairs_capacity ? broadphase->pairs_capacity * 2 : BROADPHASE_INITIAL_CAPACITY;
+                        resize_array((void**)&broadphase->pairs, sizeof(*broadphase->pairs), capacity);
+                        broadphase->pairs_capacity = capacity;
+                    }
+                    broadphase->pairs[broadphase->pairs_length++] = (BroadphasePair){ a, b };
+                }
+            }
+        }
+    }
+    return broadphase->pairs_length;
+}
+
+/**
+ * @brief Runs the exact AABB test on every candidate pair and reports the overlapping ones.
+ *
+ * @param broadphase Pointer to the Broadphase, after broadphase_find_pairs().
+ * @param callback Called with both proxy ids for each overlapping pair.
+ * @param context Opaque pointer forwarded to the callback.
+ * @return Number of overlapping pairs reported.
+ */
+size_t broadphase_narrowphase(const Broadphase* broadphase, NarrowphaseCallback callback, void* context) {
+    size_t overlaps = 0;
+    stats_add(STAT_AABB_TESTS, (unsigned)broadphase->pairs_length);
+    for (size_t i = 0; i < broadphase->pairs_length; i++) {
+        const BroadphasePair pair = broadphase->pairs[i];
+        if (!boxes_overlap(&broadphase->bounds[pair.a], &broadphase->bounds[pair.b])) continue;
+        callback(broadphase->ids[pair.a], broadphase->ids[pair.b], context);
+        overlaps++;
+    }
+    return overlaps;
+}
+
+/**
+ * @brief Finds every proxy overlapping a box whose layer is in `mask`.
+ *
+ * Only the cells covered by the box are visited, so the cost follows the local
+ * density rather than the total number of proxies.
+ *
+ * @param broadphase Pointer to the Broadphase, after broadphase_build().
+ * @param box Box to test.
+ * @param mask CollisionLayer bits the caller is interested in.
+ * @param ids Output array receiving up to `max_ids` proxy ids.
+ * @param max_ids Size of the output array.
+ * @return Number of overlapping proxies found (may exceed `max_ids`).
+ */
+size_t broadphase_query(const Broadphase* broadphase, const AABB* box, Uint32 mask, Uint32* ids, size_t max_ids) {
+    const BroadphaseCells query_cells = cells_of(box);
+    size_t found = 0;
+    unsigned tests = 0;
+    for (int row = query_cells.min_row; row <= query_cells.max_row; row++) {
+        for (int column = query_cells.min_column; column <= query_cells.max_column; column++) {
+            const int cell = row * BROADPHASE_COLUMNS + column;
+            for (Uint32 i = broadphase->cell_start[cell]; i < broadphase->cell_start[cell + 1]; i++) {
+                const Uint32 item = broadphase->cell_items[i];
+                if (!(mask & broadphase->layers[item])) continue;
+                if (!is_first_shared_cell(&query_cells, &broadphase->cells[item], column, row)) continue;
+                tests++;
+                if (!boxes_overlap(box, &broadphase->bounds[item])) continue;
+                if (found < max_ids) ids[found] = broadphase->ids[item];
+                found++;
+            }
+        }
+    }
+    stats_add(STAT_AABB_TESTS, tests);
+    return found;
+}
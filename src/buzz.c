@@ -3,9 +3,9 @@
 /**
  * @brief Creates a Buzz enemy sprite with animation frames and initializes its textures.
  *
- * This function defines frame paths for Buzz's animation, allocates
- * memory for texture pointers. It also initializes the Frames
- * structure and calls initialize_buzz() for final sprite setup.
+ * This function defines frame paths for Buzz's animation and takes the
+ * shared Frames for them from the asset cache. It then calls
+ * initialize_buzz() for final sprite setup.
  *
  * @param renderer SDL_Renderer used for texture creation
  * @return Sprite Fully initialized Buzz enemy sprite
@@ -16,19 +16,7 @@ Sprite create_buzz_enemy(SDL_Renderer* renderer) {
         "assets/sprites/enemies/buzz/buzz_2.png"
     };
     size_t frames_length = sizeof(frame_paths) / sizeof(frame_paths[0]);
-    Frames frames = {
-        frame_paths,
-        frames_length,
-        BUZZ_FRAME_DELAY,
-        malloc(sizeof(SDL_Texture*) * frames_length),
-        malloc(sizeof(int) * frames_length),
-        malloc(sizeof(int) * frames_length)
-    };
-    if (!frames.texture || !frames.widths || !frames.heights) {
-        fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
-        exit(EXIT_FAILURE);
-    }
-    load_texture(&frames, renderer);
+    Frames frames = asset_cache_acquire_frames(frame_paths, frames_length, BUZZ_FRAME_DELAY, renderer);
     return initialize_buzz(frames);
 }
 
@@ -43,19 +31,19 @@ Sprite create_buzz_enemy(SDL_Renderer* renderer) {
  */
 Sprite initialize_buzz(Frames frames) {
     Sprite buzz;
+    buzz.components = create_sprite_components(frames);
     buzz.type = BUZZ;
-    buzz.effects.effect_type = DAMAGE_EFFECT;
-    buzz.effects.life_delta = BUZZ_LIFE_DELTA;
-    buzz.effects.ring_delta = BUZZ_RING_DELTA;
+    buzz.components->effects.effect_type = DAMAGE_EFFECT;
+    buzz.components->effects.life_delta = BUZZ_LIFE_DELTA;
+    buzz.components->effects.ring_delta = BUZZ_RING_DELTA;
     buzz.scale = BUZZ_ZOOM_SCALE;
     buzz.current_frame = BUZZ_CURRENT_FRAME;
     buzz.width = frames.widths[buzz.current_frame];
     buzz.height = frames.heights[buzz.current_frame];
     buzz.x = WINDOW_WIDTH;
-    buzz.y = get_random_y_position(&buzz);
+    buzz.y = get_vertical_center_offset(&buzz); // Rolled again for every spawn
     buzz.speed = BUZZ_SPEED;
     buzz.collision_state = COLLISION_NONE;
     buzz.animation_accumulator = 0;
-    buzz.frames = frames;
     return buzz;
 }
@@ -4,7 +4,8 @@
  * @brief Emits an event indicating a change in life status between two sprites.
  *
  * This function creates and emits a game event that signifies a change in the life
- * status, involving a source and a target sprite.
+ * status, involving a source and a target sprite. The source's life delta is copied
+ * into the event so several changes to one target can be folded together.
  *
  * @param source A pointer to the source Sprite involved in the life change event.
  * @param target A pointer to the target Sprite involved in the life change event.
@@ -15,7 +16,8 @@ EmitterResult emit_life_change(Sprite* source, Sprite* target) {
         .type = EVENT_LIFE_CHANGED,
         .payload.collision = {
             .source = source,
-            .target = target
+            .target = target,
+            .delta = source->components->effects.life_delta
         }
     };
     emit_event(life_event);
@@ -26,7 +28,8 @@ EmitterResult emit_life_change(Sprite* source, Sprite* target) {
  * @brief Emits an event indicating a change in rings status between two sprites.
  *
  * This function creates and emits a game event that signifies a change in the rings
- * status, involving a source and a target sprite.
+ * status, involving a source and a target sprite. The source's ring delta is copied
+ * into the event so several changes to one target can be folded together.
  *
  * @param source A pointer to the source Sprite involved in the rings change event.
  * @param target A pointer to the target Sprite involved in the rings change event.
@@ -37,7 +40,8 @@ EmitterResult emit_rings_change(Sprite* source, Sprite* target) {
         .type = EVENT_RINGS_CHANGED,
         .payload.collision = {
             .source = source,
-            .target = target
+            .target = target,
+            .delta = source->components->effects.ring_delta
         }
     };
     emit_event(rings_event);
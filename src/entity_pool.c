@@ -0,0 +1,92 @@
+#include "game.h"
+
+/**
+ * @brief Initializes a pool around an already loaded archetype sprite.
+ *
+ * The pool takes a copy of the archetype and ownership of its frames and components,
+ * and reserves `capacity`
+ * slots in the store up front, so later acquisitions never grow the store.
+ *
+ * @param pool Pointer to the EntityPool to initialize. It must not move afterwards,
+ *        since spawned entities point to its archetype.
+ * @param archetype Sprite returned by one of the create_* functions.
+ * @param store EntityStore that will hold the pool's live entities.
+ * @param capacity Maximum number of live entities.
+ * @param spawn_interval Milliseconds between two spawns (0 spawns up to capacity at once).
+ */
+void entity_pool_init(EntityPool* pool, const Sprite* archetype, EntityStore* store, size_t capacity, Uint32 spawn_interval) {
+    pool->archetype = *archetype;
+    pool->store = store;
+    pool->capacity = capacity;
+    pool->live = 0;
+    pool->spawn_interval = spawn_interval;
+    pool->spawn_accumulator = 0;
+    store->reserved += capacity;
+    entity_store_reserve(store, store->reserved);
+}
+
+/**
+ * @brief Spawns one entity from the pool's archetype, if the pool has room left.
+ *
+ * O(1): the entity is appended to the reserved part of the store.
+ *
+ * @param pool Pointer to the EntityPool.
+ * @return Index of the spawned entity in the store, or ENTITY_NOT_FOUND when the pool is exhausted.
+ */
+size_t entity_pool_acquire(EntityPool* pool) {
+    if (pool->live == pool->capacity) return ENTITY_NOT_FOUND;
+    size_t index = entity_store_add(pool->store, &pool->archetype);
+    pool->store->pool[index] = pool;
+    pool->live++;
+    return index;
+}
+
+/**
+ * @brief Despawns an entity and gives its slot back to the pool.
+ *
+ * O(1): the store moves its last entity into the freed index. An entity despawned
+ * while touching the player leaves its collision first, so its ENTER or STAY state
+ * never survives in the freed slot.
+ *
+ * @param pool Pointer to the EntityPool the entity was acquired from.
+ * @param index Index of the entity in the store.
+ */
+void entity_pool_release(EntityPool* pool, size_t index) {
+    SDL_assert(index < pool->store->length && pool->store->pool[index] == pool);
+    if (pool->live == 0) return;
+    pool->store->collision_state[index] = COLLISION_NONE;
+    entity_store_remove(pool->store, index);
+    pool->live--;
+}
+
+/**
+ * @brief Spawns new entities as time passes, until the pool is full.
+ *
+ * Uses the same accumulator pattern as sprite_animation(). While the pool is full,
+ * the accumulator is capped so a burst of despawns is refilled one interval at a time.
+ *
+ * @param pool Pointer to the EntityPool.
+ * @param delta_time Milliseconds elapsed since last update.
+ */
+void entity_pool_update(EntityPool* pool, Uint32 delta_time) {
+    if (pool->spawn_interval == 0) {
+        while (entity_pool_acquire(pool) != ENTITY_NOT_FOUND);
+        return;
+    }
+    pool->spawn_accumulator += delta_time;
+    while (pool->spawn_accumulator >= pool->spawn_interval && pool->live < pool->capacity) {
+        entity_pool_acquire(pool);
+        pool->spawn_accumulator -= pool->spawn_interval;
+    }
+    pool->spawn_accumulator = MIN(pool->spawn_accumulator, pool->spawn_interval);
+}
+
+/**
+ * @brief Frees the archetype's frames. The store's slots are released with entity_store_free().
+ *
+ * @param pool Pointer to the EntityPool.
+ */
+void entity_pool_free(EntityPool* pool) {
+    free_sprite_frames(&pool->archetype);
+    pool->live = 0;
+}
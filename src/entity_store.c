@@ -0,0 +1,388 @@
+#include "game.h"
+
+/**
+ * @brief Resizes one of the store's parallel arrays.
+ *
+ * @param array Address of the array pointer to resize.
+ * @param element_size Size in bytes of a single element.
+ * @param capacity New number of elements the array must hold.
+ */
+static void resize_array(void** array, size_t element_size, size_t capacity) {
+    void* resized = realloc(*array, element_size * capacity);
+    if (!resized) {
+        fprintf(stderr, "Failed to allocate memory for EntityStore arrays.\n");
+        exit(EXIT_FAILURE);
+    }
+    *array = resized;
+}
+
+/**
+ * @brief Initializes an empty entity store with room for the given number of entities.
+ *
+ * @param store Pointer to the EntityStore to initialize.
+ * @param capacity Number of entities to preallocate.
+ * @param rng Generator spawn and wrap heights are drawn from.
+ */
+void entity_store_init(EntityStore* store, size_t capacity, Rng* rng) {
+    *store = (EntityStore){0};
+    store->rng = rng;
+    entity_store_reserve(store, capacity > 0 ? capacity : ENTITY_STORE_INITIAL_CAPACITY);
+}
+
+/**
+ * @brief Grows every parallel array so the store can hold at least `capacity` entities.
+ *
+ * Existing entities keep their indices. Calling it with a capacity that is not larger
+ * than the current one does nothing.
+ *
+ * @param store Pointer to the EntityStore to grow.
+ * @param capacity Minimum number of entities the store must hold.
+ */
+void entity_store_reserve(EntityStore* store, size_t capacity) {
+    if (capacity <= store->capacity) return;
+    resize_array((void**)&store->x, sizeof(*store->x), capacity);
+    resize_array((void**)&store->y, sizeof(*store->y), capacity);
+    resize_array((void**)&store->previous_x, sizeof(*store->previous_x), capacity);
+    resize_array((void**)&store->previous_y, sizeof(*store->previous_y), capacity);
+    resize_array((void**)&store->speed, sizeof(*store->speed), capacity);
+    resize_array((void**)&store->scale, sizeof(*store->scale), capacity);
+    resize_array((void**)&store->width, sizeof(*store->width), capacity);
+    resize_array((void**)&store->height, sizeof(*store->height), capacity);
+    resize_array((void**)&store->boundary_left, sizeof(*store->boundary_left), capacity);
+    resize_array((void**)&store->boundary_right, sizeof(*store->boundary_right), capacity);
+    resize_array((void**)&store->boundary_top, sizeof(*store->boundary_top), capacity);
+    resize_array((void**)&store->boundary_bottom, sizeof(*store->boundary_bottom), capacity);
+    resize_array((void**)&store->current_frame, sizeof(*store->current_frame), capacity);
+    resize_array((void**)&store->animation_accumulator, sizeof(*store->animation_accumulator), capacity);
+    resize_array((void**)&store->type, sizeof(*store->type), capacity);
+    resize_array((void**)&store->collision_state, sizeof(*store->collision_state), capacity);
+    resize_array((void**)&store->archetype, sizeof(*store->archetype), capacity);
+    resize_array((void**)&store->pool, sizeof(*store->pool), capacity);
+    resize_array((void**)&store->leaving, sizeof(*store->leaving), capacity);
+    resize_array((void**)&store->collision_mask, sizeof(*store->collision_mask), AABB_MASK_WORDS(capacity));
+    store->capacity = capacity;
+}
+
+/**
+ * @brief Releases every array owned by the store.
+ *
+ * The archetype sprites are not owned by the store and must be freed by the caller.
+ *
+ * @param store Pointer to the EntityStore to free.
+ */
+void entity_store_free(EntityStore* store) {
+    free(store->x);
+    free(store->y);
+    free(store->previous_x);
+    free(store->previous_y);
+    free(store->speed);
+    free(store->scale);
+    free(store->width);
+    free(store->height);
+    free(store->boundary_left);
+    free(store->boundary_right);
+    free(store->boundary_top);
+    free(store->boundary_bottom);
+    free(store->current_frame);
+    free(store->animation_accumulator);
+    free(store->type);
+    free(store->collision_state);
+    free(store->archetype);
+    free(store->pool);
+    free(store->leaving);
+    free(store->collision_mask);
+    *store = (EntityStore){0};
+}
+
+/**
+ * @brief Spawns a new entity from an archetype sprite.
+ *
+ * The entity copies the archetype's position, speed, scale and animation state, gets
+ * a fresh random vertical position and starts with no collision. Frames and effects
+ * stay on the archetype, which must outlive every entity spawned from it.
+ *
+ * @param store Pointer to the EntityStore receiving the entity.
+ * @param archetype Sprite created by one of the create_* functions.
+ * @return Index of the new entity.
+ */
+size_t entity_store_add(EntityStore* store, Sprite* archetype) {
+    if (store->length == store->capacity) entity_store_reserve(store, store->capacity * 2);
+    size_t index = store->length++;
+    store->x[index] = archetype->x;
+    store->y[index] = (float)get_random_y_position(store->rng, archetype);
+    store->previous_x[index] = store->x[index];
+    store->previous_y[index] = store->y[index];
+    store->speed[index] = archetype->speed;
+    store->scale[index] = archetype->scale;
+    store->width[index] = archetype->width;
+    store->height[index] = archetype->height;
+    store->current_frame[index] = archetype->current_frame;
+    store->animation_accumulator[index] = 0;
+    store->type[index] = archetype->type;
+    store->collision_state[index] = COLLISION_NONE;
+    store->archetype[index] = archetype;
+    store->pool[index] = NULL;
+    entity_store_update_boundaries(store, index);
+    return index;
+}
+
+/**
+ * @brief Removes an entity by moving the last entity into its slot.
+ *
+ * Removal is O(1) but does not preserve order: the entity previously stored last
+ * takes over `index`. Pooled entities should be removed through entity_pool_release()
+ * so their pool's live count stays accurate.
+ *
+ * @param store Pointer to the EntityStore.
+ * @param index Index of the entity to remove.
+ */
+void entity_store_remove(EntityStore* store, size_t index) {
+    if (index >= store->length) return;
+    size_t last = --store->length;
+    if (index == last) return;
+    store->x[index] = store->x[last];
+    store->y[index] = store->y[last];
+    store->previous_x[index] = store->previous_x[last];
+    store->previous_y[index] = store->previous_y[last];
+    store->speed[index] = store->speed[last];
+    store->scale[index] = store->scale[last];
+    store->width[index] = store->width[last];
+    store->height[index] = store->height[last];
+    store->boundary_left[index] = store->boundary_left[last];
+    store->boundary_right[index] = store->boundary_right[last];
+    store->boundary_top[index] = store->boundary_top[last];
+    store->boundary_bottom[index] = store->boundary_bottom[last];
+    store->current_frame[index] = store->current_frame[last];
+    store->animation_accumulator[index] = store->animation_accumulator[last];
+    store->type[index] = store->type[last];
+    store->collision_state[index] = store->collision_state[last];
+    store->archetype[index] = store->archetype[last];
+    store->pool[index] = store->pool[last];
+}
+
+/**
+ * @brief Finds the next entity of a given type, starting at `start`.
+ *
+ * Only the contiguous type array is scanned. Use ENTITY_STORE_FOR_EACH_OF_TYPE
+ * to iterate over every entity of one type.
+ *
+ * @param store Pointer to the EntityStore to search.
+ * @param type The SpriteType to look for.
+ * @param start First index to inspect.
+ * @return Index of the matching entity, or ENTITY_NOT_FOUND.
+ */
+size_t entity_store_next_of_type(const EntityStore* store, SpriteType type, size_t start) {
+    for (size_t i = start; i < store->length; i++)
+        if (store->type[i] == type) return i;
+    return ENTITY_NOT_FOUND;
+}
+
+/**
+ * @brief Animation kernel for the entities in [begin, end).
+ */
+static void animation_range(void* context, size_t begin, size_t end) {
+    EntityStoreJob* job = context;
+    EntityStore* store = job->store;
+    unsigned animated = 0;
+    for (size_t i = begin; i < end; i++) {
+        const Frames* frames = &store->archetype[i]->components->frames;
+        if (frames->delay == 0) continue;
+        animated++;
+        store->animation_accumulator[i] += job->delta_time;
+        while (store->animation_accumulator[i] >= frames->delay) {
+            store->current_frame[i] = (store->current_frame[i] + 1) % frames->length;
+            store->animation_accumulator[i] -= frames->delay;
+            store->width[i] = frames->widths[store->current_frame[i]];
+            store->height[i] = frames->heights[store->current_frame[i]];
+        }
+    }
+    atomic_fetch_add_explicit(&job->counted, animated, memory_order_relaxed);
+}
+
+/**
+ * @brief Advances the animation of every entity. Same rules as sprite_animation().
+ *
+ * @param store Pointer to the EntityStore.
+ * @param delta_time Milliseconds elapsed since last update.
+ */
+void entity_store_animation(EntityStore* store, Uint32 delta_time) {
+    EntityStoreJob job = { .store = store, .delta_time = delta_time };
+    atomic_init(&job.counted, 0);
+    parallel_for(store->length, ENTITY_STORE_MIN_JOB_CHUNK, animation_range, &job);
+    stats_add(STAT_SPRITES_ANIMATED, atomic_load_explicit(&job.counted, memory_order_relaxed));
+}
+
+/**
+ * @brief Motion kernel for the entities in [begin, end). Entities past the left edge
+ * are only flagged; releasing or wrapping them touches shared state and is left to
+ * entity_store_motion().
+ */
+static void motion_range(void* context, size_t begin, size_t end) {
+    EntityStoreJob* job = context;
+    EntityStore* store = job->store;
+    unsigned leaving = 0;
+    for (size_t i = begin; i < end; i++) {
+        const float half_width = (float)store->width[i] * store->scale[i] / 2;
+        store->x[i] += store->speed[i] * job->time_scale_factor;
+        store->leaving[i] = store->x[i] + half_width < 0;
+        if (store->leaving[i]) {
+            leaving++;
+            continue;
+        }
+        entity_store_update_boundaries(store, i);
+    }
+    atomic_fetch_add_explicit(&job->counted, leaving, memory_order_relaxed);
+}
+
+/**
+ * @brief Moves every entity horizontally and refreshes its boundaries.
+ *
+ * Pooled entities leaving the left edge are released back to their pool, which
+ * respawns them on its own schedule. Entities added without a pool keep the
+ * sprite_motion() behaviour and wrap around to the right edge at a new random height,
+ * without interpolating across the jump.
+ * Movement runs in parallel; the entities that left are then handled on the calling
+ * thread in a fixed order, so replays stay deterministic. That order is backwards, so
+ * the entity a release swaps into a freed index has already been handled.
+ *
+ * @param store Pointer to the EntityStore.
+ * @param delta_time Milliseconds elapsed since last update.
+ */
+void entity_store_motion(EntityStore* store, Uint32 delta_time) {
+    EntityStoreJob job = { .store = store, .time_scale_factor = get_time_scale_factor(delta_time) };
+    atomic_init(&job.counted, 0);
+    parallel_for(store->length, ENTITY_STORE_MIN_JOB_CHUNK, motion_range, &job);
+    if (atomic_load_explicit(&job.counted, memory_order_relaxed) == 0) return;
+    for (size_t i = store->length; i-- > 0;) {
+        if (!store->leaving[i]) continue;
+        if (store->pool[i]) {
+            entity_pool_release(store->pool[i], i);
+            continue;
+        }
+        const float half_width = (float)store->width[i] * store->scale[i] / 2;
+        store->x[i] = WINDOW_WIDTH + half_width;
+        store->y[i] = (float)get_random_y_for_size(store->rng, store->height[i], store->scale[i]);
+        store->previous_x[i] = store->x[i];
+        store->previous_y[i] = store->y[i];
+        entity_store_update_boundaries(store, i);
+    }
+}
+
+/**
+ * @brief Remembers every entity's position as the start of the next interpolation step.
+ *
+ * @param store Pointer to the EntityStore.
+ */
+void entity_store_save_previous_positions(EntityStore* store) {
+    memcpy(store->previous_x, store->x, sizeof(*store->x) * store->length);
+    memcpy(store->previous_y, store->y, sizeof(*store->y) * store->length);
+}
+
+/**
+ * @brief Recomputes the collision boundaries of one entity from its position and scaled size.
+ *
+ * @param store Pointer to the EntityStore.
+ * @param index Index of the entity to update.
+ */
+void entity_store_update_boundaries(EntityStore* store, size_t index) {
+    const float half_width = (float)store->width[index] * store->scale[index] / 2;
+    const float half_height = (float)store->height[index] * store->scale[index] / 2;
+    store->boundary_left[index] = store->x[index] - half_width;
+    store->boundary_right[index] = store->x[index] + half_width;
+    store->boundary_top[index] = store->y[index] - half_height;
+    store->boundary_bottom[index] = store->y[index] + half_height;
+}
+
+/**
+ * @brief Collision kernel for the entities in [begin, end). `begin` is a multiple of
+ * AABB_MASK_BITS, so each chunk owns whole mask words.
+ */
+static void collision_range(void* context, size_t begin, size_t end) {
+    EntityStoreJob* job = context;
+    EntityStore* store = job->store;
+    Uint32* mask = store->collision_mask + begin / AABB_MASK_BITS;
+    aabb_overlap_mask(
+        &job->sonic_box,
+        store->boundary_left + begin, store->boundary_right + begin,
+        store->boundary_top + begin, store->boundary_bottom + begin,
+        end - begin, mask
+    );
+    unsigned enters = 0;
+    for (size_t i = begin; i < end; i++) {
+        bool is_colliding = AABB_MASK_TEST(mask, i - begin);
+        switch (store->collision_state[i]) {
+            case COLLISION_NONE:
+                if (is_colliding) store->collision_state[i] = COLLISION_ENTER;
+                break;
+            case COLLISION_ENTER:
+            case COLLISION_STAY:
+                store->collision_state[i] = is_colliding ? COLLISION_STAY : COLLISION_EXIT;
+                break;
+            case COLLISION_EXIT:
+                store->collision_state[i] = is_colliding ? COLLISION_ENTER : COLLISION_NONE;
+                break;
+        }
+        enters += store->collision_state[i] == COLLISION_ENTER;
+    }
+    atomic_fetch_add_explicit(&job->counted, enters, memory_order_relaxed);
+}
+
+/**
+ * @brief Updates every entity's collision state against the player. Same state machine as update_collision_states().
+ *
+ * The overlap tests run in batches through aabb_overlap_mask() over the packed
+ * boundary arrays, one batch per job chunk; the state machine then only reads the
+ * resulting hit bitmask.
+ *
+ * @param store Pointer to the EntityStore.
+ * @param sonic Pointer to the player's sprite.
+ */
+void entity_store_update_collision_states(EntityStore* store, Sprite* sonic) {
+    EntityStoreJob job = { .store = store, .sonic_box = sprite_aabb(sonic) };
+    atomic_init(&job.counted, 0);
+    parallel_for(store->length, ENTITY_STORE_MIN_JOB_CHUNK, collision_range, &job);
+    stats_add(STAT_AABB_TESTS, (unsigned)store->length);
+    stats_add(STAT_COLLISION_ENTERS, atomic_load_explicit(&job.counted, memory_order_relaxed));
+}
+
+/**
+ * @brief Runs the collision handlers for every entity. Same dispatch as handle_collisions().
+ *
+ * Effects are emitted with the entity's archetype as the event source, since the
+ * archetype owns the effects shared by every entity spawned from it.
+ *
+ * @param store Pointer to the EntityStore.
+ * @param sonic Pointer to the player's sprite.
+ */
+void entity_store_handle_collisions(EntityStore* store, Sprite* sonic) {
+    for (size_t i = 0; i < store->length; i++) {
+        switch (store->collision_state[i]) {
+            case COLLISION_ENTER: handle_collision_enter(store->archetype[i], sonic); break;
+            case COLLISION_STAY: handle_collision_stay(store->archetype[i], sonic); break;
+            case COLLISION_EXIT:
+                store->collision_state[i] = COLLISION_NONE;
+                sonic->collision_state = COLLISION_NONE;
+                break;
+            default: break;
+        }
+    }
+}
+
+/**
+ * @brief Adds every on-screen entity to a render snapshot. Same placement as sprite_snapshot().
+ *
+ * @param store Pointer to the EntityStore.
+ * @param snapshot RenderSnapshot being built for this tick.
+ */
+void entity_store_snapshot(const EntityStore* store, RenderSnapshot* snapshot) {
+    for (size_t i = 0; i < store->length; i++) {
+        const Frames* frames = &store->archetype[i]->components->frames;
+        render_snapshot_add(snapshot, (RenderSnapshotItem){
+            frames->texture[store->current_frame[i]],
+            &frames->sources[store->current_frame[i]],
+            store->previous_x[i], store->previous_y[i], store->x[i], store->y[i],
+            (int)((float)store->width[i] * store->scale[i]), (int)((float)store->height[i] * store->scale[i]),
+            RENDER_LAYER_ENTITIES
+        });
+    }
+}
@@ -1,85 +1,425 @@
 #include "game.h"
 
+static EventSubscriberList event_subscribers[EVENT_TYPE_COUNT];
+
+static void on_life_events(const GameEvent* events, size_t length, void* context) {
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_life_event(events[i]);
+}
+
+static void on_rings_events(const GameEvent* events, size_t length, void* context) {
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_rings_event(events[i]);
+}
+
+static void on_sfx_events(const GameEvent* events, size_t length, void* context) {
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_sfx_event(events[i]);
+}
+
+static void on_music_events(const GameEvent* events, size_t length, void* context) {
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_music_event(events[i]);
+}
+
+static void on_stop_audio_events(const GameEvent* events, size_t length, void* context) {
+    (void)events;
+    (void)length;
+    (void)context;
+    handle_stop_audio_event();
+}
+
+static void on_background_events(const GameEvent* events, size_t length, void* context) {
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_background_events(events[i]);
+}
+
+static void on_game_over_events(const GameEvent* events, size_t length, void* context) {
+    (void)events;
+    (void)context;
+    for (size_t i = 0; i < length; i++) handle_game_over_event();
+}
+
 /**
- * @brief Initializes the event queue by setting the head and tail pointers to 0.
+ * @brief Initializes the global event queue and subscribes the built-in handlers.
  *
- * This function initializes the event queue by setting the head and tail pointers to 0.
- * The queue is initially empty, and the head and tail pointers are used to enqueue and
- * dequeue events.
+ * The global queue gets the default capacity and a spill buffer. Other subsystems
+ * add their own handlers afterwards with event_subscribe().
  *
  * @return void
  */
 void initialize_event_queue(void) {
-    global_queue.head = 0;
-    global_queue.tail = 0;
+    event_queue_init(&global_queue, EVENT_QUEUE_CAPACITY, true);
+    memset(event_subscribers, 0, sizeof(event_subscribers));
+    event_subscribe(EVENT_LIFE_CHANGED, on_life_events, NULL);
+    event_subscribe(EVENT_RINGS_CHANGED, on_rings_events, NULL);
+    event_subscribe(EVENT_SOUND_EFFECT, on_sfx_events, NULL);
+    event_subscribe(EVENT_MUSIC_PLAY, on_music_events, NULL);
+    event_subscribe(EVENT_STOP_AUDIO, on_stop_audio_events, NULL);
+    event_subscribe(EVENT_BACKGROUND_CHANGE, on_background_events, NULL);
+    event_subscribe(EVENT_GAME_OVER, on_game_over_events, NULL);
+}
+
+/**
+ * @brief Registers a batch handler for one event type.
+ *
+ * Each frame the handler is called with every event of that type in a contiguous
+ * span, rather than once per event. Handlers of the same type run in the order they
+ * subscribed.
+ *
+ * @param type Event type to listen to.
+ * @param handler Function receiving the span of events.
+ * @param context Pointer passed back to the handler unchanged.
+ * @return false if the type is invalid or already has EVENT_MAX_SUBSCRIBERS handlers.
+ */
+bool event_subscribe(GameEventType type, EventBatchHandler handler, void* context) {
+    if ((unsigned)type >= EVENT_TYPE_COUNT || !handler) return false;
+    EventSubscriberList* list = &event_subscribers[type];
+    if (list->length == EVENT_MAX_SUBSCRIBERS) {
+        printf("Too many subscribers for event type %d\n", type);
+        return false;
+    }
+    list->subscribers[list->length++] = (EventSubscriber){ handler, context };
+    return true;
+}
+
+/**
+ * @brief Removes a handler registered with event_subscribe(), keeping the others in order.
+ *
+ * @param type Event type the handler was registered for.
+ * @param handler Registered handler.
+ * @param context Context it was registered with.
+ */
+void event_unsubscribe(GameEventType type, EventBatchHandler handler, void* context) {
+    if ((unsigned)type >= EVENT_TYPE_COUNT) return;
+    EventSubscriberList* list = &event_subscribers[type];
+    for (size_t i = 0; i < list->length; i++) {
+        if (list->subscribers[i].handler != handler || list->subscribers[i].context != context) continue;
+        memmove(&list->subscribers[i], &list->subscribers[i + 1], sizeof(EventSubscriber) * (list->length - i - 1));
+        list->length--;
+        return;
+    }
+}
+
+/**
+ * @brief Hands a span of events of one type to every subscriber of that type.
+ */
+static void dispatch_span(GameEventType type, const GameEvent* events, size_t length) {
+    const EventSubscriberList* list = &event_subscribers[type];
+    stats_events_dispatched(type, (unsigned)length);
+    for (size_t i = 0; i < list->length; i++) list->subscribers[i].handler(events, length, list->subscribers[i].context);
+}
+
+/**
+ * @brief Initializes an empty event queue.
+ *
+ * The capacity is rounded up to a power of two so slot indices are a mask instead of
+ * a modulo. Every slot starts with its own index as sequence number, which marks it
+ * free for the producer that claims that position.
+ *
+ * @param queue A pointer to the EventQueue to initialize.
+ * @param capacity Minimum number of events the ring holds before spilling.
+ * @param spill_enabled Whether events that do not fit go to the spill buffer instead of being dropped.
+ */
+void event_queue_init(EventQueue* queue, size_t capacity, bool spill_enabled) {
+    size_t slots = 2;
+    while (slots < capacity) slots <<= 1;
+    queue->slots = malloc(sizeof(EventSlot) * slots);
+    if (!queue->slots) {
+        fprintf(stderr, "Failed to allocate memory for the event queue.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < slots; i++) atomic_init(&queue->slots[i].sequence, i);
+    queue->mask = slots - 1;
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    queue->spill_enabled = spill_enabled;
+    atomic_init(&queue->spilling, false);
+    queue->spill_lock = spill_enabled ? SDL_CreateMutex() : NULL;
+    queue->spill = NULL;
+    queue->spill_read = queue->spill_length = queue->spill_capacity = 0;
+    queue->batch = NULL;
+    queue->sorted = NULL;
+    queue->batch_capacity = 0;
+    atomic_init(&queue->high_water, 0);
+    atomic_init(&queue->spilled, 0);
+    atomic_init(&queue->dropped, 0);
+}
+
+/**
+ * @brief Frees the ring and the spill buffer. No thread may use the queue afterwards.
+ *
+ * @param queue A pointer to the EventQueue to free.
+ */
+void event_queue_free(EventQueue* queue) {
+    free(queue->slots);
+    free(queue->spill);
+    free(queue->batch);
+    free(queue->sorted);
+    if (queue->spill_lock) SDL_DestroyMutex(queue->spill_lock);
+    queue->slots = NULL;
+    queue->spill = NULL;
+    queue->batch = NULL;
+    queue->sorted = NULL;
+    queue->batch_capacity = 0;
+    queue->spill_lock = NULL;
+    queue->spill_read = queue->spill_length = queue->spill_capacity = 0;
+}
+
+/**
+ * @brief Appends an event to the spill buffer, growing it if needed.
+ *
+ * While the buffer holds events, producers keep spilling so a single producer's events
+ * still come out in the order they were queued.
+ */
+static void spill_event(EventQueue* queue, GameEvent event) {
+    SDL_LockMutex(queue->spill_lock);
+    if (queue->spill_length == queue->spill_capacity) {
+        size_t capacity = queue->spill_capacity ? queue->spill_capacity * 2 : EVENT_SPILL_INITIAL_CAPACITY;
+        GameEvent* spill = realloc(queue->spill, sizeof(GameEvent) * capacity);
+        if (!spill) {
+            fprintf(stderr, "Failed to allocate memory for the event spill buffer.\n");
+            exit(EXIT_FAILURE);
+        }
+        queue->spill = spill;
+        queue->spill_capacity = capacity;
+    }
+    queue->spill[queue->spill_length++] = event;
+    atomic_store_explicit(&queue->spilling, true, memory_order_release);
+    SDL_UnlockMutex(queue->spill_lock);
+    atomic_fetch_add_explicit(&queue->spilled, 1, memory_order_relaxed);
+}
+
+typedef struct {
+    Sprite* target;
+    GameEventType type;
+    bool negative;
+    size_t index;
+} OpenDelta;
+
+/**
+ * @brief Tells whether an event must keep its place relative to everything around it.
+ *
+ * Effects queued before a barrier are dispatched before it and effects queued after
+ * it are dispatched after it, so a sound is never folded across a stop or a new track.
+ */
+static bool is_barrier_event(GameEventType type) {
+    return type == EVENT_MUSIC_PLAY || type == EVENT_STOP_AUDIO || type == EVENT_GAME_OVER
+        || type == EVENT_STAGE_CHANGED || type == EVENT_BACKGROUND_CHANGE;
+}
+
+/**
+ * @brief Folds commuting events of one frame into one event per key, in place.
+ *
+ * Between two barrier events:
+ * - life and ring changes to the same target are summed while their deltas keep the
+ *   same sign. MAX(MAX(x + a, 0) + b, 0) equals MAX(x + a + b, 0) when a and b share
+ *   a sign, so the clamp gives the same result as applying them one by one; a change
+ *   of sign starts a new aggregate;
+ * - repeated sound effects with the same AudioID play once.
+ * Back-to-back EVENT_STOP_AUDIO collapse into one. Every aggregate stays at the
+ * position of its first event, and everything else passes through in order.
+ *
+ * @param events Events in queue order; overwritten with the coalesced list.
+ * @param length Number of events.
+ * @return Number of events left after coalescing.
+ */
+size_t coalesce_events(GameEvent* events, size_t length) {
+    bool sfx_seen[AUDIO_COUNT] = {0};
+    OpenDelta open[EVENT_COALESCE_MAX_OPEN];
+    size_t open_length = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < length; i++) {
+        const GameEvent event = events[i];
+        if (is_barrier_event(event.type)) {
+            memset(sfx_seen, 0, sizeof(sfx_seen));
+            open_length = 0;
+            if (event.type == EVENT_STOP_AUDIO && kept > 0 && events[kept - 1].type == EVENT_STOP_AUDIO) continue;
+            events[kept++] = event;
+            continue;
+        }
+        if (event.type == EVENT_SOUND_EFFECT) {
+            if (sfx_seen[event.payload.sfx.id]) continue;
+            sfx_seen[event.payload.sfx.id] = true;
+        } else if (event.type == EVENT_LIFE_CHANGED || event.type == EVENT_RINGS_CHANGED) {
+            const bool negative = event.payload.collision.delta < 0;
+            bool merged = false;
+            for (size_t j = 0; j < open_length;) {
+                if (open[j].target != event.payload.collision.target || open[j].type != event.type) {
+                    j++;
+                } else if (open[j].negative != negative) {
+                    open[j] = open[--open_length];
+                } else {
+                    events[open[j].index].payload.collision.delta += event.payload.collision.delta;
+                    merged = true;
+                    break;
+                }
+            }
+            if (merged) continue;
+            if (open_length < EVENT_COALESCE_MAX_OPEN)
+                open[open_length++] = (OpenDelta){ event.payload.collision.target, event.type, negative, kept };
+        }
+        events[kept++] = event;
+    }
+    return kept;
 }
 
 /**
  * @brief Listens for and processes events in the event queue.
  *
- * This function continuously checks the event queue for new events. When an event is found,
- * it is dequeued and processed based on its type. The function handles different event types
- * by calling the appropriate event handler functions.
+ * This function drains every event currently in the queue into a batch and coalesces
+ * it with coalesce_events(), so the dispatch cost follows the number of distinct
+ * effects rather than the number of collisions. Between barrier events the batch is
+ * bucketed by type with a stable counting sort, and each type's subscribers receive
+ * all of its events in one call. Barrier events are dispatched on their own, in queue
+ * order. Events emitted by the handlers are picked up by the next batch.
  *
  * @param queue A pointer to the EventQueue where events are stored and processed.
  */
 void event_listener(EventQueue* queue) {
     while(!is_queue_empty(queue)) {
-        GameEvent event = dequeue_event(queue);
-        switch(event.type) {
-            case EVENT_LIFE_CHANGED: handle_life_event(event); break;
-            case EVENT_RINGS_CHANGED: handle_rings_event(event); break;
-            case EVENT_SOUND_EFFECT: handle_sfx_event(event); break;
-            case EVENT_MUSIC_PLAY: handle_music_event(event); break;
-            case EVENT_STOP_AUDIO: handle_stop_audio_event(); break;
-            case EVENT_GAME_OVER: handle_game_over_event(); break;
+        size_t length = 0;
+        while(!is_queue_empty(queue)) {
+            if (length == queue->batch_capacity) {
+                size_t capacity = queue->batch_capacity ? queue->batch_capacity * 2 : EVENT_BATCH_INITIAL_CAPACITY;
+                GameEvent* batch = realloc(queue->batch, sizeof(GameEvent) * capacity);
+                if (!batch) {
+                    fprintf(stderr, "Failed to allocate memory for the event batch.\n");
+                    exit(EXIT_FAILURE);
+                }
+                GameEvent* sorted = realloc(queue->sorted, sizeof(GameEvent) * capacity);
+                if (!sorted) {
+                    fprintf(stderr, "Failed to allocate memory for the event batch.\n");
+                    exit(EXIT_FAILURE);
+                }
+                queue->batch = batch;
+                queue->sorted = sorted;
+                queue->batch_capacity = capacity;
+            }
+            queue->batch[length++] = dequeue_event(queue);
+        }
+        length = coalesce_events(queue->batch, length);
+        size_t start = 0;
+        while (start < length) {
+            const GameEventType first_type = queue->batch[start].type;
+            if (is_barrier_event(first_type)) {
+                dispatch_span(first_type, &queue->batch[start], 1);
+                start++;
+                continue;
+            }
+            size_t end = start;
+            size_t offsets[EVENT_TYPE_COUNT + 1] = {0};
+            while (end < length && !is_barrier_event(queue->batch[end].type)) {
+                offsets[queue->batch[end].type + 1]++;
+                end++;
+            }
+            for (size_t type = 0; type < EVENT_TYPE_COUNT; type++) offsets[type + 1] += offsets[type];
+            size_t cursor[EVENT_TYPE_COUNT];
+            memcpy(cursor, offsets, sizeof(cursor));
+            for (size_t i = start; i < end; i++) queue->sorted[cursor[queue->batch[i].type]++] = queue->batch[i];
+            for (size_t type = 0; type < EVENT_TYPE_COUNT; type++) {
+                if (offsets[type + 1] > offsets[type])
+                    dispatch_span((GameEventType)type, &queue->sorted[offsets[type]], offsets[type + 1] - offsets[type]);
+            }
+            start = end;
         }
     }
 }
 
 /**
- * @brief Adds an event to the event queue if there is space available.
+ * @brief Adds an event to the event queue. Safe to call from any thread.
  *
- * This function places a new event into the event queue, advancing the head
- * of the queue. If the queue is full, the event is not added.
+ * A producer claims the next position by advancing the head with a compare-and-swap,
+ * writes the event into its slot and then publishes it by bumping the slot's sequence
+ * number. When the ring is full the event is spilled, or counted as dropped if the
+ * queue has no spill buffer.
  *
  * @param queue A pointer to the EventQueue where the event will be added.
  * @param event The GameEvent to be added to the queue.
  */
 void queue_event(EventQueue* queue, GameEvent event) {
-    if((queue->head + 1) % MAX_EVENTS != queue->tail) {
-        queue->events[queue->head] = event;
-        queue->head = (queue->head + 1) % MAX_EVENTS;
+    if (atomic_load_explicit(&queue->spilling, memory_order_acquire)) {
+        spill_event(queue, event);
+        stats_event_queued(event.type);
+        return;
     }
+    size_t position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    EventSlot* slot;
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        const size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(&queue->head, &position, position + 1,
+                    memory_order_relaxed, memory_order_relaxed)) break;
+        } else if (difference < 0) {
+            if (queue->spill_enabled) {
+                spill_event(queue, event);
+                stats_event_queued(event.type);
+            } else {
+                atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+                stats_event_dropped(event.type);
+            }
+            return;
+        } else {
+            position = atomic_load_explicit(&queue->head, memory_order_relaxed);
+        }
+    }
+    slot->event = event;
+    atomic_store_explicit(&slot->sequence, position + 1, memory_order_release);
+    stats_event_queued(event.type);
+
+    const size_t occupancy = position + 1 - atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t high_water = atomic_load_explicit(&queue->high_water, memory_order_relaxed);
+    while (occupancy > high_water && !atomic_compare_exchange_weak_explicit(&queue->high_water, &high_water,
+            occupancy, memory_order_relaxed, memory_order_relaxed)) {}
 }
 
 /**
- * @brief Removes and returns the next event from the event queue.
+ * @brief Removes and returns the next event from the event queue. Consumer thread only.
  *
- * This function retrieves the event at the front of the queue and advances
- * the tail of the queue. If the queue is empty, it returns a default event.
+ * The ring is drained first, then the spill buffer, which holds the newer events.
+ * Reading a slot hands it back to producers by setting its sequence number one lap
+ * ahead. If the queue is empty, it returns a default event.
  *
  * @param queue A pointer to the EventQueue from which the event will be dequeued.
  * @return The GameEvent at the front of the queue, or a default event if the queue is empty.
  */
 GameEvent dequeue_event(EventQueue* queue) {
-    if(is_queue_empty(queue)) return (GameEvent){0};
-    GameEvent event = queue->events[queue->tail];
-    queue->tail = (queue->tail + 1) % MAX_EVENTS;
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    EventSlot* slot = &queue->slots[tail & queue->mask];
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) == tail + 1) {
+        GameEvent event = slot->event;
+        atomic_store_explicit(&slot->sequence, tail + queue->mask + 1, memory_order_release);
+        atomic_store_explicit(&queue->tail, tail + 1, memory_order_relaxed);
+        return event;
+    }
+    GameEvent event = {0};
+    if (!atomic_load_explicit(&queue->spilling, memory_order_acquire)) return event;
+    SDL_LockMutex(queue->spill_lock);
+    if (queue->spill_read < queue->spill_length) event = queue->spill[queue->spill_read++];
+    if (queue->spill_read == queue->spill_length) {
+        queue->spill_read = queue->spill_length = 0;
+        atomic_store_explicit(&queue->spilling, false, memory_order_release);
+    }
+    SDL_UnlockMutex(queue->spill_lock);
     return event;
 }
 
 /**
- * @brief Checks if the event queue is empty.
+ * @brief Checks if the event queue has nothing ready for the consumer.
  *
- * This function checks if the event queue is empty by comparing the head and tail pointers.
- * If the head and tail pointers are equal, it means the queue is empty.
+ * An event is ready once its producer has published the slot; a slot still being
+ * written counts as empty and is picked up on the next call.
  *
  * @param queue A pointer to the EventQueue to be checked.
  * @return true if the event queue is empty, false otherwise.
  */
 bool is_queue_empty(const EventQueue* queue) {
-    return queue->head == queue->tail;
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    const EventSlot* slot = &queue->slots[tail & queue->mask];
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) != tail + 1
+        && !atomic_load_explicit(&queue->spilling, memory_order_acquire);
 }
 
 /**
@@ -158,43 +498,41 @@ void handle_background_events(GameEvent event) {
  * @brief Handles life-related events, updating the target sprite's life.
  *
  * This function processes life-related events by updating the target
- * sprite's life based on the life delta value from the source sprite's effects.
+ * sprite's life based on the life delta carried by the event.
  * The life value is clamped to a minimum of 0. If the target sprite's
  * life drops to or below 0, the game over start event is emitted.
  *
  * @param event The GameEvent containing the collision information and source/target sprites.
  * @param event.payload.collision.source A pointer to the source sprite involved in the collision.
  * @param event.payload.collision.target A pointer to the target sprite involved in the collision.
- * @param event.payload.collision.source->effects.life_delta The life delta value to be applied to the target sprite's life.
+ * @param event.payload.collision.delta The life delta value to be applied to the target sprite's life.
  *
  * @return void
  *
  * @see emit_game_over_start
  */
 void handle_life_event(GameEvent event) {
-    Sprite* source = event.payload.collision.source;
     Sprite* target = event.payload.collision.target;
-    target->life = MAX(target->life + source->effects.life_delta, 0);
-    if (target->life <= 0) emit_game_over_start();
+    target->components->stats.life = MAX(target->components->stats.life + event.payload.collision.delta, 0);
+    if (target->components->stats.life <= 0) emit_game_over_start();
 }
 
 /**
  * @brief Handles ring-related events, updating the target sprite's rings.
  *
  * This function processes ring-related events by updating the target sprite's rings based on the ring delta
- * value from the source sprite's effects. The rings value is clamped to a minimum of 0.
+ * carried by the event. The rings value is clamped to a minimum of 0.
  *
  * @param event The GameEvent containing the collision information and source/target sprites.
  * @param event.payload.collision.source A pointer to the source sprite involved in the collision.
  * @param event.payload.collision.target A pointer to the target sprite involved in the collision.
- * @param event.payload.collision.source->effects.ring_delta The ring delta value to be applied to the target sprite's rings.
+ * @param event.payload.collision.delta The ring delta value to be applied to the target sprite's rings.
  *
  * @return void
  */
 void handle_rings_event(GameEvent event) {
-    Sprite* source = event.payload.collision.source;
     Sprite* target = event.payload.collision.target;
-    target->rings = MAX(target->rings + source->effects.ring_delta, 0);
+    target->components->stats.rings = MAX(target->components->stats.rings + event.payload.collision.delta, 0);
 }
 
 /**
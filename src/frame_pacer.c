@@ -0,0 +1,137 @@
+#include "game.h"
+
+/**
+ * @brief Adds one frame interval to the rolling window, evicting the oldest one when full.
+ */
+static void record_interval(FramePacer* pacer, Uint64 counts) {
+    const Uint64 microseconds = counts * 1000000 / pacer->frequency;
+    const Uint32 interval = microseconds > SDL_MAX_UINT32 ? SDL_MAX_UINT32 : (Uint32)microseconds;
+    Uint32 bucket = interval / FRAME_PACER_BUCKET_US;
+    if (bucket >= FRAME_PACER_BUCKETS) bucket = FRAME_PACER_BUCKETS - 1;
+
+    if (pacer->interval_count == FRAME_PACER_HISTORY) {
+        pacer->buckets[pacer->interval_buckets[pacer->interval_next]]--;
+    } else {
+        pacer->interval_count++;
+    }
+    pacer->intervals[pacer->interval_next] = interval;
+    pacer->interval_buckets[pacer->interval_next] = (Uint16)bucket;
+    pacer->buckets[bucket]++;
+    pacer->interval_next = (pacer->interval_next + 1) % FRAME_PACER_HISTORY;
+}
+
+/**
+ * @brief Returns the upper edge, in milliseconds, of the bucket holding the given percentile.
+ */
+static double bucket_percentile(const FramePacer* pacer, double percentile) {
+    const size_t rank = (size_t)((double)pacer->interval_count * percentile + 0.5);
+    size_t seen = 0;
+    for (size_t bucket = 0; bucket < FRAME_PACER_BUCKETS; bucket++) {
+        seen += pacer->buckets[bucket];
+        if (seen >= rank && seen > 0) return (double)((bucket + 1) * FRAME_PACER_BUCKET_US) / 1000.0;
+    }
+    return (double)(FRAME_PACER_BUCKETS * FRAME_PACER_BUCKET_US) / 1000.0;
+}
+
+/**
+ * @brief Sets up a pacer for a target frame rate.
+ *
+ * In FRAME_PACER_SLEEP mode frames are held until evenly spaced deadlines. In
+ * FRAME_PACER_VSYNC mode SDL_RenderPresent() already waits for the display, so waiting
+ * here as well would throttle each frame twice; the pacer only measures, and falls back
+ * to sleeping if frames turn out to arrive much faster than `rate` (vsync disabled by
+ * the driver or the user).
+ *
+ * @param pacer Pointer to the FramePacer to initialize.
+ * @param rate Target frames per second; in vsync mode, the display's refresh rate.
+ * @param mode Whether the pacer or the display sets the pace.
+ */
+void frame_pacer_init(FramePacer* pacer, int rate, FramePacerMode mode) {
+    memset(pacer, 0, sizeof(*pacer));
+    if (rate <= 0) rate = FRAME_PACER_DEFAULT_RATE;
+    pacer->mode = mode;
+    pacer->rate = rate;
+    pacer->frequency = SDL_GetPerformanceFrequency();
+    pacer->target_counts = pacer->frequency / (Uint64)rate;
+    pacer->spin_counts = pacer->frequency * FRAME_PACER_SPIN_MS / 1000;
+    pacer->last_frame = SDL_GetPerformanceCounter();
+    pacer->deadline = pacer->last_frame + pacer->target_counts;
+}
+
+/**
+ * @brief Waits out the rest of the frame, then records how long the frame took.
+ *
+ * Call once per frame, right after SDL_RenderPresent(). The wait sleeps with
+ * SDL_Delay() until FRAME_PACER_SPIN_MS before the deadline, since the scheduler can
+ * overshoot a sleep by a millisecond or more, and spins on the performance counter for
+ * the last stretch. Deadlines advance by exactly one frame so rounding never
+ * accumulates; a frame that misses its deadline by more than a whole frame restarts
+ * the schedule instead of rushing the following ones.
+ *
+ * @param pacer Pointer to the FramePacer.
+ */
+void frame_pacer_end_frame(FramePacer* pacer) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (pacer->mode == FRAME_PACER_SLEEP) {
+        if (now < pacer->deadline) {
+            const Uint64 remaining = pacer->deadline - now;
+            if (remaining > pacer->spin_counts) {
+                SDL_Delay((Uint32)((remaining - pacer->spin_counts) * 1000 / pacer->frequency));
+            }
+            do {
+                now = SDL_GetPerformanceCounter();
+            } while (now < pacer->deadline);
+        }
+        pacer->deadline += pacer->target_counts;
+        if (now > pacer->deadline) pacer->deadline = now + pacer->target_counts;
+    }
+
+    record_interval(pacer, now - pacer->last_frame);
+    pacer->last_frame = now;
+    pacer->frames++;
+
+    if (pacer->mode == FRAME_PACER_VSYNC && pacer->interval_count == FRAME_PACER_HISTORY) {
+        const double target_ms = 1000.0 / pacer->rate;
+        if (bucket_percentile(pacer, 0.5) < target_ms * FRAME_PACER_VSYNC_TOLERANCE) {
+            printf("Frames arrive faster than the %d Hz refresh rate, vsync looks disabled: pacing in software\n", pacer->rate);
+            pacer->mode = FRAME_PACER_SLEEP;
+            pacer->deadline = now + pacer->target_counts;
+        }
+    }
+}
+
+/**
+ * @brief Summarizes the frame intervals in the rolling window.
+ *
+ * Percentiles are resolved to FRAME_PACER_BUCKET_US; the maximum is exact.
+ *
+ * @param pacer Pointer to the FramePacer.
+ * @param stats Output for the median, 99th percentile and maximum interval.
+ */
+void frame_pacer_stats(const FramePacer* pacer, FramePacerStats* stats) {
+    stats->samples = pacer->interval_count;
+    if (pacer->interval_count == 0) {
+        stats->p50_ms = stats->p99_ms = stats->max_ms = 0.0;
+        return;
+    }
+    Uint32 max = 0;
+    for (size_t i = 0; i < pacer->interval_count; i++) {
+        if (pacer->intervals[i] > max) max = pacer->intervals[i];
+    }
+    stats->p50_ms = bucket_percentile(pacer, 0.5);
+    stats->p99_ms = bucket_percentile(pacer, 0.99);
+    stats->max_ms = (double)max / 1000.0;
+}
+
+/**
+ * @brief Prints the frame interval statistics of the rolling window.
+ *
+ * @param pacer Pointer to the FramePacer.
+ */
+void frame_pacer_log(const FramePacer* pacer) {
+    FramePacerStats stats;
+    frame_pacer_stats(pacer, &stats);
+    printf("Frame pacing (%s, %d Hz, last %zu of %llu frames): p50 %.1f ms, p99 %.1f ms, max %.2f ms\n",
+        pacer->mode == FRAME_PACER_VSYNC ? "vsync" : "sleep", pacer->rate, stats.samples,
+        (unsigned long long)pacer->frames, stats.p50_ms, stats.p99_ms, stats.max_ms);
+}
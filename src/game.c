@@ -3,9 +3,20 @@
 EventQueue global_queue;
 GameOverState game_over_state;
 
-int main(void) {
+int main(int argc, char* argv[]) {
+    const Uint64 startup_start = SDL_GetPerformanceCounter();
+    PROFILE_THREAD("main");
+    GameOptions options;
+    if (!options_parse(argc, argv, &options)) {
+        options_print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    // Headless runs need neither a display nor a sound card
+    if (options.headless) {
+        SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
     initialize_event_queue();
-    srand((unsigned int)time(NULL)); // Seed the random generator 
 
     // Initialize SDL with video and image support
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
@@ -21,13 +32,40 @@ int main(void) {
     }
 
     // Initialize SDL_mixer for sound support
-    if(Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
+    if(Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
         printf("SDL_mixer initialization failed: %s\n", Mix_GetError());
         IMG_Quit();
         SDL_Quit();
         return EXIT_FAILURE;
     }
 
+    // Same seed and same input give the same session; a replay brings both.
+    // It is read before any asset is loaded, so a bad replay has nothing to release.
+    Replay replay;
+    if (options.replay_path) {
+        if (!replay_load(&replay, options.replay_path)) {
+            Mix_CloseAudio();
+            Mix_Quit();
+            IMG_Quit();
+            SDL_Quit();
+            return EXIT_FAILURE;
+        }
+        printf("Replaying %u ticks from %s\n", replay.tick_count, options.replay_path);
+    } else {
+        replay_init(&replay, options.record_path ? REPLAY_RECORD : REPLAY_OFF,
+            options.has_seed ? options.seed : (Uint64)time(NULL));
+    }
+    printf("Seed: %llu\n", (unsigned long long)replay.seed);
+
+    // Map the baked asset pack; anything missing from it is loaded from the source files
+    if (asset_pack_open(ASSET_PACK_PATH)) {
+        printf("Asset pack: %zu asset(s) from %s\n", asset_pack_entry_count(), ASSET_PACK_PATH);
+    } else {
+        printf("Asset pack not found, loading assets from the source files\n");
+    }
+    // Decode images and audio on worker threads while the window and renderer are created
+    loader_start();
+
     char window_title[128];
     snprintf(window_title, sizeof(window_title), "%s - v%s", GAME_TITLE, GAME_VERSION);
     // Create a window
@@ -40,32 +78,53 @@ int main(void) {
     );
     if (!window) {
         printf("Window creation failed: %s\n", SDL_GetError());
+        loader_cleanup();
+        Mix_CloseAudio();
+        pcm_cache_cleanup();
+        asset_pack_close();
+        Mix_Quit();
+        replay_free(&replay);
         IMG_Quit();
         SDL_Quit();
         return EXIT_FAILURE;
     }
 
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");  // Linear filtering
-    // Create accelerated vsync'd renderer
+    // Create accelerated vsync'd renderer; headless runs only need one to create textures
     SDL_Renderer* renderer = SDL_CreateRenderer(
         window,
         -1,
-        SDL_RENDERER_ACCELERATED |
-        SDL_RENDERER_PRESENTVSYNC
+        options.headless ? SDL_RENDERER_SOFTWARE : SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
     );
 
     if (!renderer) {
         printf("Renderer creation failed: %s\n", SDL_GetError());
+        loader_cleanup();
+        Mix_CloseAudio();
+        pcm_cache_cleanup();
+        asset_pack_close();
+        Mix_Quit();
+        replay_free(&replay);
         SDL_DestroyWindow(window);
         IMG_Quit();
         SDL_Quit();
         return EXIT_FAILURE;
     }
 
+    // Wait for the decoders, only the texture uploads are left to do on this thread
+    printf("Assets decoded in %.2f ms on %d worker thread(s)\n", loader_wait(), loader_worker_count());
+
     // Load background image
-    SDL_Texture* background = IMG_LoadTexture(renderer, "assets/backgrounds/stage3_bg.png");
+    SDL_Texture* background = asset_cache_acquire_texture(STAGE_BACKGROUND_PATH, renderer, NULL);
     if (!background) {
         printf("Background loading failed: %s\n", IMG_GetError());
+        loader_cleanup();
+        asset_cache_cleanup();
+        Mix_CloseAudio();
+        pcm_cache_cleanup();
+        asset_pack_close();
+        Mix_Quit();
+        replay_free(&replay);
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         IMG_Quit();
@@ -73,23 +132,49 @@ int main(void) {
         return EXIT_FAILURE;
     }
 
-    Sprite sonic = create_sonic(renderer);
-    // Sprite ring = create_ring(renderer);
-    // Sprite life = create_life(renderer);
-    Sprite buzz = create_buzz_enemy(renderer);
-    Sprite game_over = create_game_over(renderer);
-    Sprite *sprites[] = {
-        // &ring,
-        // &life,
-        &buzz
-    };
-    size_t sprites_length = sizeof(sprites) / sizeof(sprites[0]);
+    if (atlas_build_sprite_registry(renderer)) {
+        printf("Sprite atlas: %zu page(s)\n", atlas_page_count());
+    } else {
+        printf("Sprite atlas unavailable, using one texture per frame\n");
+    }
+
+    if (jobs_start(0)) printf("Job workers: %d\n", jobs_worker_count());
+    static GameWorld world;
+    world_init(&world, renderer, &replay);
+
+    RenderBatch render_batch;
+    render_batch_init(&render_batch, RENDER_BATCH_INITIAL_CAPACITY);
+    const SDL_FRect background_rect = { 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT };
 
     audio_initialization();
+    loader_cleanup();
 
     // Game loop variables
     bool quit = false;
+    bool first_frame_presented = false;
     SDL_Event event;
+    // With vsync, present already waits for the display; otherwise the pacer holds each frame
+    FramePacer frame_pacer;
+    SDL_RendererInfo renderer_info;
+    SDL_DisplayMode display_mode;
+    if (SDL_GetRendererInfo(renderer, &renderer_info) == 0 && (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC)) {
+        const bool refresh_known = SDL_GetWindowDisplayMode(window, &display_mode) == 0 && display_mode.refresh_rate > 0;
+        frame_pacer_init(&frame_pacer, refresh_known ? display_mode.refresh_rate : FRAME_PACER_DEFAULT_RATE, FRAME_PACER_VSYNC);
+    } else {
+        frame_pacer_init(&frame_pacer, FRAME_PACER_DEFAULT_RATE, FRAME_PACER_SLEEP);
+    }
+    // The simulation ticks on its own thread while this one draws and presents
+    Simulation simulation;
+    simulation_init(&simulation, &world);
+
+    if (options.headless) {
+        const double seconds = world_run_headless(&world, options.headless_ticks);
+        printf("Headless: %u ticks in %.3f s (%.0f ticks/s)\n",
+            world.tick, seconds, seconds > 0.0 ? world.tick / seconds : 0.0);
+        quit = true;
+    } else {
+        simulation_start(&simulation);
+    }
 
     // Main game loop
     while (!quit) {
@@ -98,57 +183,67 @@ int main(void) {
             if (event.type == SDL_QUIT) {
                 quit = true; // Exit when the window is closed
             }
+            if (event.type == SDL_KEYDOWN && event.key.keysym.scancode == SDL_SCANCODE_F3 && !event.key.repeat) {
+                stats_toggle_overlay();
+            }
         }
 
-        static Uint32 last_frame_time = 0;
-        Uint32 current_time = SDL_GetTicks();
-        Uint32 delta_time = current_time - last_frame_time;
-
-        // Cap to ~60 FPS (16ms per frame)
-        if (delta_time < TARGET_FRAME_TIME) {
-            SDL_Delay(TARGET_FRAME_TIME - delta_time);
-            current_time = SDL_GetTicks();
-            delta_time = current_time - last_frame_time;
+        simulation_set_input(&simulation, input_read_keyboard());
+        if (!simulation.thread) simulation_update(&simulation);
+        if (simulation_finished(&simulation)) quit = true;
+        const RenderSnapshot* snapshot = render_snapshot_acquire(&simulation.snapshots);
+        const float alpha = simulation_alpha(&simulation, snapshot);
+
+        {
+            PROFILE_SCOPE("render");
+            SDL_RenderClear(renderer); // Clear the screen
+            render_batch_submit(&render_batch, background, NULL, &background_rect, RENDER_LAYER_BACKGROUND);
+            render_snapshot_submit(snapshot, &render_batch, alpha);
+            render_batch_flush(&render_batch, renderer);
+            stats_render_overlay(renderer);
         }
+        {
+            PROFILE_SCOPE("present");
+            SDL_RenderPresent(renderer); // Update the display
+        }
+        if (!first_frame_presented) {
+            first_frame_presented = true;
+            printf("Time to first frame: %.2f ms\n",
+                (double)(SDL_GetPerformanceCounter() - startup_start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+        }
+        {
+            PROFILE_SCOPE("pace");
+            frame_pacer_end_frame(&frame_pacer);
+        }
+        PROFILE_FRAME_END();
+        stats_end_frame();
+    }
 
-        sprite_animation(&sonic, delta_time);
-        // sprite_animation(&ring, delta_time);
-        // sprite_animation(&life, delta_time);
-        sprite_animation(&buzz, delta_time);
-
-        sonic_motion(&sonic, delta_time);
-        // sprite_motion(&ring, delta_time);
-        // sprite_motion(&life, delta_time);
-        sprite_motion(&buzz, delta_time);
-        game_over_motion(&game_over, delta_time);
-
-        update_collision_states(&sonic, sprites, sprites_length);
-        handle_collisions(&sonic, sprites, sprites_length);
-
-        event_listener(&global_queue);
-
-        SDL_RenderClear(renderer); // Clear the screen
-        SDL_RenderCopy(renderer, background, NULL, NULL); // Render the background
-
-        sprite_render(&sonic, renderer);
-        // sprite_render(&ring, renderer);
-        // sprite_render(&life, renderer);
-        sprite_render(&buzz, renderer);
-        sprite_render(&game_over, renderer);
+    simulation_free(&simulation);
+    if (!options.headless) frame_pacer_log(&frame_pacer);
 
-        SDL_RenderPresent(renderer); // Update the display
-        last_frame_time = current_time; // Update timing for next frame
+    if (options.record_path && replay_save(&replay, options.record_path)) {
+        printf("Recorded %u ticks (%zu input runs) to %s\n", replay.tick_count, replay.length, options.record_path);
     }
 
     // Clean up
-    free_sprite_frames(&sonic);
-    // free_sprite_frames(&ring);
-    // free_sprite_frames(&life);
-    free_sprite_frames(&buzz);
-    free_sprite_frames(&game_over);
-    SDL_DestroyTexture(background);
+    render_batch_free(&render_batch);
+    world_free(&world);
+    jobs_stop();
+    replay_free(&replay);
+    asset_cache_release_texture(STAGE_BACKGROUND_PATH);
+    atlas_destroy();
+    asset_cache_cleanup();
     audio_cleanup();
+    printf("Audio commands dropped: %zu\n", audio_thread_dropped());
+    printf("Event queue: high water %zu of %zu, %zu spilled, %zu dropped\n",
+        atomic_load(&global_queue.high_water), global_queue.mask + 1,
+        atomic_load(&global_queue.spilled), atomic_load(&global_queue.dropped));
+    event_queue_free(&global_queue);
+    PROFILE_REPORT(PROFILER_TRACE_PATH);
     Mix_CloseAudio();
+    pcm_cache_cleanup();
+    asset_pack_close();
     Mix_Quit();
     SDL_DestroyRenderer(renderer);
     SDL_DestroyWindow(window);
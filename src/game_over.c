@@ -3,8 +3,8 @@
 /**
  * @brief Creates a Game Over sprite with specified frames.
  *
- * This function initializes a Game Over sprite by loading the necessary frames,
- * setting up the animation, and allocating memory for the frames' resources.
+ * This function initializes a Game Over sprite by taking the necessary frames
+ * from the asset cache and setting up the animation.
  *
  * @param renderer The SDL_Renderer used to create the textures for the frames.
  * @return A Sprite structure representing the initialized Game Over.
@@ -12,19 +12,7 @@
 Sprite create_game_over(SDL_Renderer* renderer) {
     const char* frame_paths[] = { "assets/images/game_over.png" };
     size_t frames_length = sizeof(frame_paths) / sizeof(frame_paths[0]);
-    Frames frames = {
-        frame_paths,
-        frames_length,
-        GAME_OVER_FRAME_DELAY,
-        malloc(sizeof(SDL_Texture*) * frames_length),
-        malloc(sizeof(int) * frames_length),
-        malloc(sizeof(int) * frames_length)
-    };
-    if (!frames.texture || !frames.widths || !frames.heights) {
-        fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
-        exit(EXIT_FAILURE);
-    }
-    load_texture(&frames, renderer);
+    Frames frames = asset_cache_acquire_frames(frame_paths, frames_length, GAME_OVER_FRAME_DELAY, renderer);
     printf("After load_texture: %d\n", frames.widths[0]);
     return initialize_game_over(frames);
 }
@@ -43,6 +31,7 @@ Sprite create_game_over(SDL_Renderer* renderer) {
  */
 Sprite initialize_game_over(Frames frames) {
     Sprite game_over;
+    game_over.components = create_sprite_components(frames);
     game_over.type = GAME_OVER;
     game_over.scale = GAME_OVER_ZOOM_SCALE;
     game_over.current_frame = GAME_OVER_CURRENT_FRAME;
@@ -50,9 +39,7 @@ Sprite initialize_game_over(Frames frames) {
     game_over.height = frames.heights[game_over.current_frame];
     game_over.x = GAME_OVER_INITIAL_X;
     game_over.y = GAME_OVER_INITIAL_Y;
-    game_over.target_y = GAME_OVER_TARGET_Y;
     game_over.speed = GAME_OVER_SPEED;
-    game_over.frames = frames;
     return game_over;
 }
 
@@ -71,5 +58,5 @@ Sprite initialize_game_over(Frames frames) {
 void game_over_motion(Sprite *game_over, Uint32 delta_time) {
     if (!game_over_state.is_active) return;
     game_over->y += game_over->speed * get_time_scale_factor(delta_time);
-    if (game_over->y < game_over->target_y) game_over->y = game_over->target_y;
+    if (game_over->y < GAME_OVER_TARGET_Y) game_over->y = GAME_OVER_TARGET_Y;
 }
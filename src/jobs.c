@@ -0,0 +1,190 @@
+#include "game.h"
+
+static JobDeque job_deques[JOBS_MAX_WORKERS + 1];
+static SDL_Thread* job_threads[JOBS_MAX_WORKERS];
+static int job_workers = 0;
+static int job_threads_started = 0;
+static SDL_sem* job_wakeup = NULL;
+static atomic_bool jobs_stopping;
+static _Thread_local int job_deque_index = 0;
+
+/**
+ * @brief Pushes a job at the bottom of the caller's own deque.
+ *
+ * @return false when the deque is full; the caller then runs the job itself.
+ */
+static bool deque_push(JobDeque* deque, Job* job) {
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    const long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= JOBS_DEQUE_CAPACITY) return false;
+    atomic_store_explicit(&deque->jobs[bottom % JOBS_DEQUE_CAPACITY], job, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Takes the most recently pushed job from the caller's own deque.
+ */
+static Job* deque_take(JobDeque* deque) {
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+    Job* job = atomic_load_explicit(&deque->jobs[bottom % JOBS_DEQUE_CAPACITY], memory_order_relaxed);
+    if (top == bottom) {
+        // Last job: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+            job = NULL;
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return job;
+}
+
+/**
+ * @brief Steals the oldest job from another thread's deque.
+ */
+static Job* deque_steal(JobDeque* deque) {
+    long long top = atomic_load_explicit(&deque->top, memory_order_seq_cst);
+    const long long bottom = atomic_load_explicit(&deque->bottom, memory_order_seq_cst);
+    if (top >= bottom) return NULL;
+    Job* job = atomic_load_explicit(&deque->jobs[top % JOBS_DEQUE_CAPACITY], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed))
+        return NULL;
+    return job;
+}
+
+/**
+ * @brief Finds work for a thread: its own deque first, then every other deque in turn.
+ */
+static Job* find_job(int self) {
+    Job* job = deque_take(&job_deques[self]);
+    for (int i = 1; !job && i <= job_workers; i++) job = deque_steal(&job_deques[(self + i) % (job_workers + 1)]);
+    return job;
+}
+
+static void run_job(Job* job) {
+    job->function(job->context, job->begin, job->end);
+    atomic_fetch_sub_explicit(&job->batch->remaining, 1, memory_order_release);
+}
+
+/**
+ * @brief Worker loop: runs and steals jobs, spins briefly when idle, then sleeps until
+ * parallel_for() posts more work.
+ */
+static int job_worker(void* data) {
+    job_deque_index = (int)(intptr_t)data;
+    PROFILE_THREAD("jobs");
+    while (!atomic_load_explicit(&jobs_stopping, memory_order_acquire)) {
+        Job* job = NULL;
+        for (int attempt = 0; !job && attempt < JOBS_SPIN_ATTEMPTS; attempt++) job = find_job(job_deque_index);
+        if (job) {
+            run_job(job);
+            continue;
+        }
+        SDL_SemWait(job_wakeup);
+    }
+    return 0;
+}
+
+/**
+ * @brief Starts the worker threads. Deque 0 belongs to the one thread that issues
+ * parallel_for() calls (the simulation), which takes part in every call it issues.
+ *
+ * @param workers Number of extra threads, or 0 for one per core besides the caller's.
+ * @return true if the workers run. If any of them cannot be created, none are kept and
+ * parallel_for() runs inline.
+ */
+bool jobs_start(int workers) {
+    jobs_stop();
+    if (workers <= 0) workers = SDL_GetCPUCount() - 1;
+    if (workers > JOBS_MAX_WORKERS) workers = JOBS_MAX_WORKERS;
+    if (workers <= 0) return false;
+    for (int i = 0; i <= JOBS_MAX_WORKERS; i++) {
+        atomic_init(&job_deques[i].top, 0);
+        atomic_init(&job_deques[i].bottom, 0);
+    }
+    atomic_store(&jobs_stopping, false);
+    job_deque_index = 0;
+    job_wakeup = SDL_CreateSemaphore(0);
+    if (!job_wakeup) return false;
+    // Workers read job_workers to pick steal victims, so it is set before any of them starts
+    job_workers = workers;
+    for (job_threads_started = 0; job_threads_started < workers; job_threads_started++) {
+        job_threads[job_threads_started] = SDL_CreateThread(job_worker, "jobs", (void*)(intptr_t)(job_threads_started + 1));
+        if (!job_threads[job_threads_started]) {
+            printf("Job threads unavailable, entity updates run on the main thread: %s\n", SDL_GetError());
+            jobs_stop();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Stops and joins the worker threads. parallel_for() runs inline afterwards.
+ */
+void jobs_stop(void) {
+    if (!job_wakeup) return;
+    atomic_store_explicit(&jobs_stopping, true, memory_order_release);
+    for (int i = 0; i < job_threads_started; i++) SDL_SemPost(job_wakeup);
+    for (int i = 0; i < job_threads_started; i++) SDL_WaitThread(job_threads[i], NULL);
+    SDL_DestroySemaphore(job_wakeup);
+    job_wakeup = NULL;
+    job_threads_started = 0;
+    job_workers = 0;
+}
+
+/**
+ * @brief Number of worker threads besides the caller's.
+ */
+int jobs_worker_count(void) {
+    return job_workers;
+}
+
+/**
+ * @brief Runs `function` over [0, count) split into chunks, in parallel, and returns
+ * once every chunk has finished.
+ *
+ * Chunks are multiples of JOBS_CHUNK_ALIGNMENT items, so a chunk never shares a
+ * collision mask word with its neighbours, and no smaller than `min_chunk`. They are
+ * pushed on the caller's deque for the workers to steal; the caller runs chunks too
+ * while it waits. Small ranges, or a stopped job system, run inline.
+ *
+ * Chunks must only write the items of their own range. Anything else has to be
+ * deferred until this returns, or sent through the event queue.
+ *
+ * @param count Number of items.
+ * @param min_chunk Smallest chunk worth handing to another thread.
+ * @param function Called with [begin, end) for every chunk.
+ * @param context Passed through to `function`.
+ */
+void parallel_for(size_t count, size_t min_chunk, JobFunction function, void* context) {
+    if (count == 0) return;
+    const size_t threads = (size_t)job_workers + 1;
+    size_t chunk = MAX(min_chunk, (count + threads * JOBS_CHUNKS_PER_WORKER - 1) / (threads * JOBS_CHUNKS_PER_WORKER));
+    chunk = MAX(chunk, (count + JOBS_MAX_CHUNKS - 1) / JOBS_MAX_CHUNKS);
+    chunk = (chunk + JOBS_CHUNK_ALIGNMENT - 1) / JOBS_CHUNK_ALIGNMENT * JOBS_CHUNK_ALIGNMENT;
+    if (job_workers == 0 || count <= chunk) {
+        function(context, 0, count);
+        return;
+    }
+
+    Job jobs[JOBS_MAX_CHUNKS];
+    JobBatch batch;
+    const size_t chunks = (count + chunk - 1) / chunk;
+    atomic_init(&batch.remaining, chunks);
+    JobDeque* own = &job_deques[job_deque_index];
+    for (size_t i = chunks; i-- > 0;) {
+        jobs[i] = (Job){ function, context, i * chunk, MIN(count, (i + 1) * chunk), &batch };
+        if (!deque_push(own, &jobs[i])) run_job(&jobs[i]);
+    }
+    for (size_t i = 0; i < MIN(chunks - 1, (size_t)job_workers); i++) SDL_SemPost(job_wakeup);
+
+    while (atomic_load_explicit(&batch.remaining, memory_order_acquire) > 0) {
+        Job* job = find_job(job_deque_index);
+        if (job) run_job(job);
+    }
+}
@@ -17,19 +17,7 @@ Sprite create_life(SDL_Renderer* renderer) {
         "assets/sprites/extra_lives/life_2.png"
     };
     size_t frames_length = sizeof(frame_paths) / sizeof(frame_paths[0]);
-    Frames frames = {
-        frame_paths,
-        frames_length,
-        LIFE_FRAME_DELAY,
-        malloc(sizeof(SDL_Texture*) * frames_length),
-        malloc(sizeof(int) * frames_length),
-        malloc(sizeof(int) * frames_length)
-    };
-    if (!frames.texture || !frames.widths || !frames.heights) {
-        fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
-        exit(EXIT_FAILURE);
-    }
-    load_texture(&frames, renderer);
+    Frames frames = asset_cache_acquire_frames(frame_paths, frames_length, LIFE_FRAME_DELAY, renderer);
     return initialize_life(frames);
 }
 
@@ -46,18 +34,18 @@ Sprite create_life(SDL_Renderer* renderer) {
  */
 Sprite initialize_life(Frames frames) {
     Sprite life;
+    life.components = create_sprite_components(frames);
     life.type = LIFE;
-    life.effects.effect_type = LIFE_EFFECT;
-    life.effects.life_delta = LIFE_DELTA;
+    life.components->effects.effect_type = LIFE_EFFECT;
+    life.components->effects.life_delta = LIFE_DELTA;
     life.scale = LIFE_ZOOM_SCALE;
     life.collision_state = COLLISION_NONE;
     life.width = frames.widths[life.collision_state];
     life.height = frames.heights[life.collision_state];
     life.x = WINDOW_WIDTH;
-    life.y = get_random_y_position(&life);
+    life.y = get_vertical_center_offset(&life); // Rolled again for every spawn
     life.speed = LIFE_SPEED;
     life.current_frame = LIFE_CURRENT_FRAME;
     life.animation_accumulator = 0;
-    life.frames = frames;
     return life;
 }
@@ -0,0 +1,181 @@
+#include "game.h"
+
+static LoaderJob loader_jobs[] = {
+    { STAGE_BACKGROUND_PATH, LOADER_IMAGE, NULL, NULL, NULL },
+    #define SPRITE_ENTRY(path) { path, LOADER_IMAGE, NULL, NULL, NULL },
+    #include "sprite_registry.def"
+    #undef SPRITE_ENTRY
+    #define AUDIO_ENTRY(id, path, is_music) { path, (is_music) ? LOADER_MUSIC : LOADER_SOUND, NULL, NULL, NULL },
+    #include "audio_registry.def"
+    #undef AUDIO_ENTRY
+};
+
+static SDL_Thread* loader_threads[LOADER_MAX_WORKERS];
+static int loader_threads_length = 0;
+static int loader_workers_started = 0;
+static SDL_atomic_t loader_next_job;
+static SDL_mutex* mixer_lock = NULL;
+static Uint64 loader_start_time = 0;
+static bool loader_active = false;
+
+/**
+ * @brief Worker loop: claims jobs in registry order until none are left.
+ *
+ * Images decode fully in parallel. SDL_mixer sets its decoders up lazily and does not
+ * document that as thread-safe, so audio jobs take mixer_lock and decode one at a time,
+ * still alongside the image decoding and the main thread's window creation.
+ */
+static int loader_worker(void* data) {
+    (void)data;
+    PROFILE_THREAD("loader");
+    for (;;) {
+        const int index = SDL_AtomicAdd(&loader_next_job, 1);
+        if (index >= (int)SDL_arraysize(loader_jobs)) return 0;
+        PROFILE_SCOPE("decode");
+        LoaderJob* job = &loader_jobs[index];
+        if (job->kind == LOADER_IMAGE) {
+            job->surface = asset_pack_load_surface(job->path);
+            continue;
+        }
+        if (mixer_lock) SDL_LockMutex(mixer_lock);
+        if (job->kind == LOADER_SOUND) job->chunk = asset_pack_load_chunk(job->path);
+        else job->music = asset_pack_load_music(job->path);
+        if (mixer_lock) SDL_UnlockMutex(mixer_lock);
+    }
+}
+
+/**
+ * @brief Finds the job for a path, waiting for the workers first if they are still running.
+ *
+ * @return The job, or NULL when the loader is not active or the path is not preloaded.
+ */
+static LoaderJob* find_job(const char* path, LoaderKind kind) {
+    if (!loader_active) return NULL;
+    loader_wait();
+    for (size_t i = 0; i < SDL_arraysize(loader_jobs); i++)
+        if (loader_jobs[i].kind == kind && strcmp(loader_jobs[i].path, path) == 0) return &loader_jobs[i];
+    return NULL;
+}
+
+/**
+ * @brief Starts decoding the background, the sprite registry and the audio registry on worker threads.
+ *
+ * Must run after IMG_Init and Mix_OpenAudio, so sounds are converted to the final mixer
+ * spec, and after asset_pack_open so the workers read from the pack when there is one.
+ * The main thread is free to create the window and renderer meanwhile; GPU uploads
+ * stay on the main thread and take the decoded data through loader_take_*().
+ * Falls back to loading everything on demand if no thread can be started.
+ */
+void loader_start(void) {
+    loader_cleanup();
+    loader_start_time = SDL_GetPerformanceCounter();
+    loader_active = true;
+    SDL_AtomicSet(&loader_next_job, 0);
+    mixer_lock = SDL_CreateMutex();
+    int workers = SDL_GetCPUCount() - 1;
+    if (workers < 1) workers = 1;
+    if (workers > LOADER_MAX_WORKERS) workers = LOADER_MAX_WORKERS;
+    for (int i = 0; i < workers; i++) {
+        SDL_Thread* thread = SDL_CreateThread(loader_worker, "loader", NULL);
+        if (!thread) break;
+        loader_threads[loader_threads_length++] = thread;
+    }
+    loader_workers_started = loader_threads_length;
+    if (loader_threads_length == 0) {
+        printf("Loader threads unavailable, loading assets on demand: %s\n", SDL_GetError());
+        loader_active = false;
+    }
+}
+
+/**
+ * @brief Blocks until every worker has finished. Safe to call more than once.
+ *
+ * @return Milliseconds between loader_start() and the moment the last worker finished.
+ */
+double loader_wait(void) {
+    static double elapsed = 0.0;
+    if (loader_threads_length == 0) return elapsed;
+    for (int i = 0; i < loader_threads_length; i++) SDL_WaitThread(loader_threads[i], NULL);
+    loader_threads_length = 0;
+    elapsed = (double)(SDL_GetPerformanceCounter() - loader_start_time) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return elapsed;
+}
+
+/**
+ * @brief Number of worker threads started by the last loader_start().
+ */
+int loader_worker_count(void) {
+    return loader_workers_started;
+}
+
+/**
+ * @brief Hands over the preloaded surface for a path; the caller frees it.
+ *
+ * Paths that were not preloaded, already taken or failed to decode are loaded now
+ * on the calling thread, so the caller sees the usual error on failure.
+ *
+ * @param path Path of the image.
+ * @return The surface, or NULL if the image could not be loaded.
+ */
+SDL_Surface* loader_take_surface(const char* path) {
+    LoaderJob* job = find_job(path, LOADER_IMAGE);
+    if (job && job->surface) {
+        SDL_Surface* surface = job->surface;
+        job->surface = NULL;
+        return surface;
+    }
+    return asset_pack_load_surface(path);
+}
+
+/**
+ * @brief Hands over the preloaded sound effect for a path; the caller frees it.
+ *
+ * @param path Path of the sound file.
+ * @return The chunk, or NULL if the sound could not be loaded.
+ */
+Mix_Chunk* loader_take_chunk(const char* path) {
+    LoaderJob* job = find_job(path, LOADER_SOUND);
+    if (job && job->chunk) {
+        Mix_Chunk* chunk = job->chunk;
+        job->chunk = NULL;
+        return chunk;
+    }
+    return asset_pack_load_chunk(path);
+}
+
+/**
+ * @brief Hands over the preloaded music for a path; the caller frees it.
+ *
+ * @param path Path of the music file.
+ * @return The music, or NULL if it could not be loaded.
+ */
+Mix_Music* loader_take_music(const char* path) {
+    LoaderJob* job = find_job(path, LOADER_MUSIC);
+    if (job && job->music) {
+        Mix_Music* music = job->music;
+        job->music = NULL;
+        return music;
+    }
+    return asset_pack_load_music(path);
+}
+
+/**
+ * @brief Joins the workers and frees whatever was decoded but never taken.
+ *
+ * Later loader_take_*() calls load directly from the pack or the source files.
+ */
+void loader_cleanup(void) {
+    loader_wait();
+    loader_active = false;
+    for (size_t i = 0; i < SDL_arraysize(loader_jobs); i++) {
+        LoaderJob* job = &loader_jobs[i];
+        if (job->surface) SDL_FreeSurface(job->surface);
+        if (job->chunk) Mix_FreeChunk(job->chunk);
+        if (job->music) Mix_FreeMusic(job->music);
+        job->surface = NULL;
+        job->chunk = NULL;
+        job->music = NULL;
+    }
+    if (mixer_lock) SDL_DestroyMutex(mixer_lock);
+    mixer_lock = NULL;
+}
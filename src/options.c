@@ -0,0 +1,86 @@
+#include "game.h"
+#include <errno.h>
+
+/**
+ * @brief Parses a tick count: a positive decimal integer that fits in a Uint32.
+ */
+static bool parse_ticks(const char* text, Uint32* ticks) {
+    char* end = NULL;
+    const unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-' || value == 0 || value > SDL_MAX_UINT32) return false;
+    *ticks = (Uint32)value;
+    return true;
+}
+
+/**
+ * @brief Parses a seed: any decimal integer that fits in a Uint64.
+ */
+static bool parse_seed(const char* text, Uint64* seed) {
+    char* end = NULL;
+    errno = 0;
+    const unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-' || errno == ERANGE) return false;
+    *seed = (Uint64)value;
+    return true;
+}
+
+/**
+ * @brief Reads the command line.
+ *
+ * Supported flags:
+ *   --headless N     Run N simulation ticks without a display, audio device or frame
+ *                    pacing, then report the tick rate.
+ *   --seed N         Seed the world's random generator instead of using the clock.
+ *   --record FILE    Save the seed and every tick's input to FILE at exit.
+ *   --replay FILE    Replay a recorded session; the run ends with the recording.
+ *
+ * @param argc Argument count from main().
+ * @param argv Argument vector from main().
+ * @param options Output for the parsed options; defaults to a normal windowed run.
+ * @return false if an argument is unknown or malformed.
+ */
+bool options_parse(int argc, char* argv[], GameOptions* options) {
+    *options = (GameOptions){0};
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            if (i + 1 >= argc || !parse_ticks(argv[i + 1], &options->headless_ticks)) {
+                fprintf(stderr, "--headless expects a positive tick count\n");
+                return false;
+            }
+            options->headless = true;
+            i++;
+        } else if (strcmp(argv[i], "--seed") == 0) {
+            if (i + 1 >= argc || !parse_seed(argv[i + 1], &options->seed)) {
+                fprintf(stderr, "--seed expects an unsigned integer\n");
+                return false;
+            }
+            options->has_seed = true;
+            i++;
+        } else if (strcmp(argv[i], "--record") == 0 || strcmp(argv[i], "--replay") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "%s expects a file path\n", argv[i]);
+                return false;
+            }
+            if (strcmp(argv[i], "--record") == 0) options->record_path = argv[i + 1];
+            else options->replay_path = argv[i + 1];
+            i++;
+        } else {
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return false;
+        }
+    }
+    if (options->record_path && options->replay_path) {
+        fprintf(stderr, "--record and --replay cannot be combined\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Prints the supported command-line flags.
+ *
+ * @param program Name the game was started with (argv[0]).
+ */
+void options_print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s [--headless TICKS] [--seed N] [--record FILE | --replay FILE]\n", program);
+}
@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 200809L
+#include "game.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static PcmCacheMapping* pcm_mappings = NULL;
+static size_t pcm_mappings_length = 0;
+static size_t pcm_mappings_capacity = 0;
+
+/**
+ * @brief Builds the cache file name for a source path from its 64-bit FNV-1a hash.
+ */
+static void cache_file_path(const char* path, char* buffer, size_t size) {
+    Uint64 hash = 14695981039346656037ull;
+    for (const char* c = path; *c; c++) {
+        hash ^= (Uint8)*c;
+        hash *= 1099511628211ull;
+    }
+    snprintf(buffer, size, "%s/%016llx.pcm", PCM_CACHE_DIRECTORY, (unsigned long long)hash);
+}
+
+/**
+ * @brief Fills the header a cache file for `path` must carry to be valid right now.
+ *
+ * @return false if the source file or the mixer spec cannot be queried.
+ */
+static bool expected_header(const char* path, PcmCacheHeader* header) {
+    struct stat status;
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    if (strlen(path) >= PCM_CACHE_PATH_LENGTH || stat(path, &status) != 0) return false;
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) return false;
+    *header = (PcmCacheHeader){0};
+    header->magic = PCM_CACHE_MAGIC;
+    header->version = PCM_CACHE_VERSION;
+    header->source_mtime = (Sint64)status.st_mtime;
+    header->source_size = (Uint64)status.st_size;
+    header->frequency = (Uint32)frequency;
+    header->format = format;
+    header->channels = (Uint16)channels;
+    strcpy(header->path, path);
+    return true;
+}
+
+/**
+ * @brief Maps a cache file and wraps its samples in a chunk if its header matches.
+ *
+ * @return The chunk, or NULL on a miss or a stale file.
+ */
+static Mix_Chunk* load_cached(const char* file_path, const PcmCacheHeader* expected) {
+    const int descriptor = open(file_path, O_RDONLY);
+    if (descriptor < 0) return NULL;
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || (size_t)status.st_size < sizeof(PcmCacheHeader)) {
+        close(descriptor);
+        return NULL;
+    }
+    const size_t size = (size_t)status.st_size;
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) return NULL;
+
+    const PcmCacheHeader* header = mapping;
+    const bool valid = header->magic == expected->magic && header->version == expected->version
+        && header->source_mtime == expected->source_mtime && header->source_size == expected->source_size
+        && header->frequency == expected->frequency && header->format == expected->format
+        && header->channels == expected->channels && strcmp(header->path, expected->path) == 0
+        && header->data_size == size - sizeof(PcmCacheHeader) && header->data_size <= SDL_MAX_UINT32;
+    Mix_Chunk* chunk = valid
+        ? Mix_QuickLoad_RAW((Uint8*)mapping + sizeof(PcmCacheHeader), (Uint32)header->data_size)
+        : NULL;
+    if (!chunk) {
+        munmap(mapping, size);
+        return NULL;
+    }
+    if (pcm_mappings_length == pcm_mappings_capacity) {
+        pcm_mappings_capacity = pcm_mappings_capacity ? pcm_mappings_capacity * 2 : 16;
+        PcmCacheMapping* mappings = realloc(pcm_mappings, sizeof(PcmCacheMapping) * pcm_mappings_capacity);
+        if (!mappings) {
+            fprintf(stderr, "Failed to allocate memory for the PCM cache.\n");
+            exit(EXIT_FAILURE);
+        }
+        pcm_mappings = mappings;
+    }
+    pcm_mappings[pcm_mappings_length++] = (PcmCacheMapping){ mapping, size };
+    return chunk;
+}
+
+/**
+ * @brief Writes a decoded chunk to the cache. Failures only cost the next launch a decode.
+ *
+ * The file is written under a temporary name and renamed into place, so an interrupted
+ * write never leaves a truncated file that looks valid. Nothing is cached when the
+ * temporary name does not fit in PATH_MAX.
+ */
+static void store_cached(const char* file_path, PcmCacheHeader header, const Mix_Chunk* chunk) {
+    if ((mkdir("build", 0755) != 0 && errno != EEXIST) || (mkdir(PCM_CACHE_DIRECTORY, 0755) != 0 && errno != EEXIST)) return;
+    char temporary_path[PATH_MAX];
+    const int length = snprintf(temporary_path, sizeof(temporary_path), "%s.tmp", file_path);
+    if (length < 0 || (size_t)length >= sizeof(temporary_path)) return;
+    FILE* file = fopen(temporary_path, "wb");
+    if (!file) return;
+    header.data_size = chunk->alen;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && (chunk->alen == 0 || fwrite(chunk->abuf, chunk->alen, 1, file) == 1);
+    written = fclose(file) == 0 && written;
+    if (!written || rename(temporary_path, file_path) != 0) remove(temporary_path);
+}
+
+/**
+ * @brief Loads a sound effect as mixer-format PCM, decoding it only when the cache is stale.
+ *
+ * On a hit the cache file is mapped and the chunk plays straight out of the mapping,
+ * which stays mapped until pcm_cache_cleanup(). On a miss the file is decoded with
+ * Mix_LoadWAV and the result is written to the cache for the next launch. Must run
+ * after Mix_OpenAudio, whose spec is part of the cache key.
+ *
+ * @param path Path of the sound file.
+ * @return The chunk, or NULL if the sound could not be loaded.
+ */
+Mix_Chunk* pcm_cache_load_chunk(const char* path) {
+    PcmCacheHeader header;
+    if (!expected_header(path, &header)) return Mix_LoadWAV(path);
+    char file_path[PATH_MAX];
+    cache_file_path(path, file_path, sizeof(file_path));
+    Mix_Chunk* chunk = load_cached(file_path, &header);
+    if (chunk) return chunk;
+    chunk = Mix_LoadWAV(path);
+    if (chunk) store_cached(file_path, header, chunk);
+    return chunk;
+}
+
+/**
+ * @brief Unmaps every cache file. Every chunk returned from a cache hit must be freed first.
+ */
+void pcm_cache_cleanup(void) {
+    for (size_t i = 0; i < pcm_mappings_length; i++) munmap(pcm_mappings[i].data, pcm_mappings[i].size);
+    free(pcm_mappings);
+    pcm_mappings = NULL;
+    pcm_mappings_length = pcm_mappings_capacity = 0;
+}
@@ -0,0 +1,210 @@
+#include "game.h"
+
+static ProfileThread* profile_threads[PROFILER_MAX_THREADS];
+static atomic_uint profile_thread_count;
+static _Thread_local ProfileThread* profile_current = NULL;
+static atomic_uint profile_frame;
+static ProfilePhase profile_phases[PROFILER_MAX_PHASES];
+static size_t profile_phases_length = 0;
+static Uint64 profile_last_frame = 0;
+
+/**
+ * @brief Returns the calling thread's ring, creating and registering it on first use.
+ *
+ * @return NULL when PROFILER_MAX_THREADS threads already record, or allocation fails.
+ */
+static ProfileThread* current_thread(void) {
+    if (profile_current) return profile_current;
+    const unsigned id = atomic_fetch_add(&profile_thread_count, 1);
+    if (id >= PROFILER_MAX_THREADS) return NULL;
+    ProfileThread* thread = calloc(1, sizeof(ProfileThread));
+    if (!thread) return NULL;
+    thread->id = id;
+    thread->name = "thread";
+    profile_threads[id] = thread;
+    profile_current = thread;
+    return thread;
+}
+
+/**
+ * @brief Starts a timer. Use PROFILE_SCOPE(), which stops it when the scope exits.
+ *
+ * @param name Phase name; must be a string literal or otherwise outlive the profiler.
+ */
+ProfileScope profile_scope_begin(const char* name) {
+    ProfileThread* thread = current_thread();
+    if (thread) thread->depth++;
+    return (ProfileScope){ name, SDL_GetPerformanceCounter() };
+}
+
+/**
+ * @brief Stops a timer and appends the sample to the calling thread's ring.
+ *
+ * Only the owning thread writes its ring; the head is published with a release store
+ * so the exporter sees complete samples.
+ *
+ * @param scope Timer returned by profile_scope_begin().
+ */
+void profile_scope_end(ProfileScope* scope) {
+    const Uint64 end = SDL_GetPerformanceCounter();
+    ProfileThread* thread = current_thread();
+    if (!thread) return;
+    thread->depth--;
+    const size_t head = atomic_load_explicit(&thread->head, memory_order_relaxed);
+    thread->samples[head % PROFILER_RING_CAPACITY] = (ProfileSample){
+        scope->name, scope->start, end, atomic_load_explicit(&profile_frame, memory_order_relaxed), thread->depth
+    };
+    atomic_store_explicit(&thread->head, head + 1, memory_order_release);
+}
+
+/**
+ * @brief Names the calling thread in the trace.
+ *
+ * @param name Thread name; must be a string literal or otherwise outlive the profiler.
+ */
+void profile_thread_name(const char* name) {
+    ProfileThread* thread = current_thread();
+    if (thread) thread->name = name;
+}
+
+/**
+ * @brief Returns the summary slot of a phase, adding it on first sight.
+ */
+static ProfilePhase* find_phase(const char* name) {
+    for (size_t i = 0; i < profile_phases_length; i++)
+        if (profile_phases[i].name == name || strcmp(profile_phases[i].name, name) == 0) return &profile_phases[i];
+    if (profile_phases_length == PROFILER_MAX_PHASES) return NULL;
+    ProfilePhase* phase = &profile_phases[profile_phases_length++];
+    *phase = (ProfilePhase){0};
+    phase->name = name;
+    return phase;
+}
+
+static void push_phase(ProfilePhase* phase, Uint64 counts) {
+    phase->window_ms[phase->next] = (float)((double)counts * 1000.0 / (double)SDL_GetPerformanceFrequency());
+    phase->next = (phase->next + 1) % PROFILER_HISTORY;
+    if (phase->length < PROFILER_HISTORY) phase->length++;
+}
+
+/**
+ * @brief Closes the frame on the calling (main) thread.
+ *
+ * Sums this frame's samples per phase name and adds the totals to each phase's rolling
+ * window, along with the whole frame interval under "frame". A phase that did not run
+ * this frame adds nothing. Phases recorded on other threads (simulation, jobs, loader,
+ * audio) only appear in the trace.
+ */
+void profile_frame_end(void) {
+    ProfileThread* thread = current_thread();
+    if (!thread) return;
+    const Uint64 now = SDL_GetPerformanceCounter();
+    const size_t head = atomic_load_explicit(&thread->head, memory_order_relaxed);
+    size_t start = thread->frame_start;
+    if (head - start > PROFILER_RING_CAPACITY) start = head - PROFILER_RING_CAPACITY;
+
+    for (size_t i = 0; i < profile_phases_length; i++) {
+        profile_phases[i].frame_counts = 0;
+        profile_phases[i].seen = false;
+    }
+    for (size_t i = start; i < head; i++) {
+        const ProfileSample* sample = &thread->samples[i % PROFILER_RING_CAPACITY];
+        ProfilePhase* phase = find_phase(sample->name);
+        if (!phase) continue;
+        phase->frame_counts += sample->end - sample->start;
+        phase->seen = true;
+    }
+    for (size_t i = 0; i < profile_phases_length; i++)
+        if (profile_phases[i].seen) push_phase(&profile_phases[i], profile_phases[i].frame_counts);
+    if (profile_last_frame) {
+        ProfilePhase* frame = find_phase("frame");
+        if (frame) push_phase(frame, now - profile_last_frame);
+    }
+
+    profile_last_frame = now;
+    thread->frame_start = head;
+    atomic_fetch_add_explicit(&profile_frame, 1, memory_order_relaxed);
+}
+
+static int compare_floats(const void* a, const void* b) {
+    const float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Prints p50/p99/max of every phase's per-frame time over the last PROFILER_HISTORY frames.
+ */
+static void log_summary(void) {
+    printf("%-20s %8s %9s %9s %9s\n", "phase", "frames", "p50 ms", "p99 ms", "max ms");
+    for (size_t i = 0; i < profile_phases_length; i++) {
+        const ProfilePhase* phase = &profile_phases[i];
+        if (phase->length == 0) continue;
+        float sorted[PROFILER_HISTORY];
+        memcpy(sorted, phase->window_ms, sizeof(float) * phase->length);
+        qsort(sorted, phase->length, sizeof(float), compare_floats);
+        const size_t p50 = (phase->length - 1) / 2;
+        const size_t p99 = (phase->length - 1) * 99 / 100;
+        printf("%-20s %8zu %9.3f %9.3f %9.3f\n", phase->name, phase->length,
+            sorted[p50], sorted[p99], sorted[phase->length - 1]);
+    }
+}
+
+/**
+ * @brief Writes every thread's ring as Chrome trace events: one complete ("X") event
+ * per sample, tagged with its frame number, plus the thread names.
+ */
+static bool write_trace(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Failed to create %s\n", path);
+        return false;
+    }
+    const double us_per_count = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    Uint64 origin = SDL_MAX_UINT64;
+    const unsigned thread_count = MIN(atomic_load(&profile_thread_count), PROFILER_MAX_THREADS);
+    for (unsigned t = 0; t < thread_count; t++) {
+        const ProfileThread* thread = profile_threads[t];
+        if (!thread) continue;
+        const size_t head = atomic_load_explicit(&thread->head, memory_order_acquire);
+        const size_t start = head > PROFILER_RING_CAPACITY ? head - PROFILER_RING_CAPACITY : 0;
+        for (size_t i = start; i < head; i++) origin = MIN(origin, thread->samples[i % PROFILER_RING_CAPACITY].start);
+    }
+
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    for (unsigned t = 0; t < thread_count; t++) {
+        const ProfileThread* thread = profile_threads[t];
+        if (!thread) continue;
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            first ? "" : ",\n", thread->id, thread->name);
+        first = false;
+        const size_t head = atomic_load_explicit(&thread->head, memory_order_acquire);
+        const size_t start = head > PROFILER_RING_CAPACITY ? head - PROFILER_RING_CAPACITY : 0;
+        for (size_t i = start; i < head; i++) {
+            const ProfileSample* sample = &thread->samples[i % PROFILER_RING_CAPACITY];
+            fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%u}}",
+                sample->name, thread->id, (double)(sample->start - origin) * us_per_count,
+                (double)(sample->end - sample->start) * us_per_count, sample->frame);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Prints the phase summary, writes the trace and frees the rings.
+ *
+ * Call at exit, once every other thread that recorded samples has been joined.
+ *
+ * @param trace_path Destination of the Chrome trace JSON.
+ */
+void profile_report(const char* trace_path) {
+    log_summary();
+    if (write_trace(trace_path)) printf("Profiler trace written to %s\n", trace_path);
+    const unsigned thread_count = MIN(atomic_load(&profile_thread_count), PROFILER_MAX_THREADS);
+    for (unsigned t = 0; t < thread_count; t++) {
+        free(profile_threads[t]);
+        profile_threads[t] = NULL;
+    }
+    atomic_store(&profile_thread_count, 0);
+    profile_current = NULL;
+}
@@ -0,0 +1,184 @@
+#include "game.h"
+
+#define VERTICES_PER_QUAD 4
+#define INDICES_PER_QUAD 6
+
+/**
+ * @brief qsort comparator: layer first, then texture, then submission order.
+ *
+ * The submission order keeps the sort stable, so quads sharing a layer and a texture
+ * are drawn in the order they were submitted.
+ */
+static int compare_quads(const void* a, const void* b) {
+    const RenderQuad* quad_a = a;
+    const RenderQuad* quad_b = b;
+    if (quad_a->layer != quad_b->layer) return quad_a->layer < quad_b->layer ? -1 : 1;
+    if (quad_a->texture != quad_b->texture) return (uintptr_t)quad_a->texture < (uintptr_t)quad_b->texture ? -1 : 1;
+    if (quad_a->sequence != quad_b->sequence) return quad_a->sequence < quad_b->sequence ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Grows the shared vertex and index buffers to hold `quads` quads.
+ *
+ * The index buffer only depends on the quad count, so it is filled once here and
+ * reused by every draw call: each call passes its own vertex pointer and the same
+ * leading indices.
+ */
+static void ensure_geometry_capacity(RenderBatch* batch, size_t quads) {
+    if (quads <= batch->geometry_capacity) return;
+    SDL_Vertex* vertices = realloc(batch->vertices, sizeof(SDL_Vertex) * VERTICES_PER_QUAD * quads);
+    int* indices = realloc(batch->indices, sizeof(int) * INDICES_PER_QUAD * quads);
+    if (!vertices || !indices) {
+        fprintf(stderr, "Failed to allocate memory for RenderBatch geometry.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t quad = batch->geometry_capacity; quad < quads; quad++) {
+        const int first = (int)(quad * VERTICES_PER_QUAD);
+        int* quad_indices = &indices[quad * INDICES_PER_QUAD];
+        quad_indices[0] = first;
+        quad_indices[1] = first + 1;
+        quad_indices[2] = first + 2;
+        quad_indices[3] = first + 2;
+        quad_indices[4] = first + 1;
+        quad_indices[5] = first + 3;
+    }
+    batch->vertices = vertices;
+    batch->indices = indices;
+    batch->geometry_capacity = quads;
+}
+
+/**
+ * @brief Writes the four corners of a quad: top-left, top-right, bottom-left, bottom-right.
+ */
+static void write_quad_vertices(SDL_Vertex* vertices, const RenderQuad* quad, float texture_width, float texture_height) {
+    const SDL_Color white = { 255, 255, 255, 255 };
+    const float left = quad->destination.x;
+    const float top = quad->destination.y;
+    const float right = left + quad->destination.w;
+    const float bottom = top + quad->destination.h;
+    const float u0 = (float)quad->source.x / texture_width;
+    const float v0 = (float)quad->source.y / texture_height;
+    const float u1 = (float)(quad->source.x + quad->source.w) / texture_width;
+    const float v1 = (float)(quad->source.y + quad->source.h) / texture_height;
+    vertices[0] = (SDL_Vertex){ { left, top }, white, { u0, v0 } };
+    vertices[1] = (SDL_Vertex){ { right, top }, white, { u1, v0 } };
+    vertices[2] = (SDL_Vertex){ { left, bottom }, white, { u0, v1 } };
+    vertices[3] = (SDL_Vertex){ { right, bottom }, white, { u1, v1 } };
+}
+
+/**
+ * @brief Initializes an empty draw list with room for `capacity` quads.
+ *
+ * @param batch Pointer to the RenderBatch to initialize.
+ * @param capacity Number of quads to preallocate.
+ */
+void render_batch_init(RenderBatch* batch, size_t capacity) {
+    *batch = (RenderBatch){0};
+    batch->capacity = capacity > 0 ? capacity : RENDER_BATCH_INITIAL_CAPACITY;
+    batch->quads = malloc(sizeof(RenderQuad) * batch->capacity);
+    if (!batch->quads) {
+        fprintf(stderr, "Failed to allocate memory for RenderBatch quads.\n");
+        exit(EXIT_FAILURE);
+    }
+    ensure_geometry_capacity(batch, batch->capacity);
+}
+
+/**
+ * @brief Releases the quad list and geometry buffers.
+ *
+ * @param batch Pointer to the RenderBatch to free.
+ */
+void render_batch_free(RenderBatch* batch) {
+    free(batch->quads);
+    free(batch->vertices);
+    free(batch->indices);
+    *batch = (RenderBatch){0};
+}
+
+/**
+ * @brief Queues one textured quad for the current frame.
+ *
+ * @param batch Pointer to the RenderBatch.
+ * @param texture Texture to sample.
+ * @param source Region of the texture to draw, or NULL for the whole texture.
+ * @param destination Target rectangle in window coordinates.
+ * @param layer Layer the quad is drawn in; lower layers are drawn first.
+ */
+void render_batch_submit(RenderBatch* batch, SDL_Texture* texture, const SDL_Rect* source, const SDL_FRect* destination, RenderLayer layer) {
+    if (batch->length == batch->capacity) {
+        size_t capacity = batch->capacity * 2;
+        RenderQuad* quads = realloc(batch->quads, sizeof(RenderQuad) * capacity);
+        if (!quads) {
+            fprintf(stderr, "Failed to allocate memory for RenderBatch quads.\n");
+            exit(EXIT_FAILURE);
+        }
+        batch->quads = quads;
+        batch->capacity = capacity;
+    }
+    RenderQuad* quad = &batch->quads[batch->length];
+    quad->texture = texture;
+    if (source) {
+        quad->source = *source;
+    } else {
+        quad->source = (SDL_Rect){0};
+        SDL_QueryTexture(texture, NULL, NULL, &quad->source.w, &quad->source.h);
+    }
+    quad->destination = *destination;
+    quad->layer = layer;
+    quad->sequence = (Uint32)batch->length;
+    batch->length++;
+}
+
+/**
+ * @brief Draws every queued quad and empties the list.
+ *
+ * Quads are sorted by layer and texture, then each run of consecutive quads sharing a
+ * texture is drawn with one SDL_RenderGeometry call over the shared vertex and index
+ * buffers. With the sprite atlas this is roughly one call per atlas page and layer.
+ * SDL versions older than 2.0.18 lack SDL_RenderGeometry and fall back to one
+ * SDL_RenderCopyF per quad.
+ *
+ * @param batch Pointer to the RenderBatch.
+ * @param renderer SDL_Renderer target for drawing operations.
+ * @return Number of draw calls issued.
+ */
+size_t render_batch_flush(RenderBatch* batch, SDL_Renderer* renderer) {
+    batch->draw_calls = 0;
+    qsort(batch->quads, batch->length, sizeof(RenderQuad), compare_quads);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    ensure_geometry_capacity(batch, batch->length);
+    size_t run_start = 0;
+    while (run_start < batch->length) {
+        SDL_Texture* texture = batch->quads[run_start].texture;
+        int texture_width = 1, texture_height = 1;
+        SDL_QueryTexture(texture, NULL, NULL, &texture_width, &texture_height);
+        size_t run_end = run_start;
+        while (run_end < batch->length && batch->quads[run_end].texture == texture) {
+            write_quad_vertices(
+                &batch->vertices[run_end * VERTICES_PER_QUAD], &batch->quads[run_end],
+                (float)texture_width, (float)texture_height
+            );
+            run_end++;
+        }
+        const size_t run_length = run_end - run_start;
+        SDL_RenderGeometry(
+            renderer, texture,
+            &batch->vertices[run_start * VERTICES_PER_QUAD], (int)(run_length * VERTICES_PER_QUAD),
+            batch->indices, (int)(run_length * INDICES_PER_QUAD)
+        );
+        batch->draw_calls++;
+        stats_add(STAT_TEXTURE_SWITCHES, 1);
+        run_start = run_end;
+    }
+#else
+    for (size_t i = 0; i < batch->length; i++) {
+        SDL_RenderCopyF(renderer, batch->quads[i].texture, &batch->quads[i].source, &batch->quads[i].destination);
+        batch->draw_calls++;
+        if (i == 0 || batch->quads[i].texture != batch->quads[i - 1].texture) stats_add(STAT_TEXTURE_SWITCHES, 1);
+    }
+#endif
+    stats_add(STAT_RENDER_CALLS, (unsigned)batch->draw_calls);
+    batch->length = 0;
+    return batch->draw_calls;
+}
@@ -0,0 +1,139 @@
+#include "game.h"
+
+/**
+ * @brief Prepares the three empty slots: the simulation writes slot 0, the renderer
+ * reads slot 1 and slot 2 starts as the (empty) latest snapshot.
+ *
+ * @param buffer Pointer to the RenderSnapshotBuffer to initialize.
+ */
+void render_snapshot_buffer_init(RenderSnapshotBuffer* buffer) {
+    for (int i = 0; i < RENDER_SNAPSHOT_SLOTS; i++) {
+        RenderSnapshot* snapshot = &buffer->slots[i];
+        *snapshot = (RenderSnapshot){0};
+        snapshot->items = malloc(sizeof(RenderSnapshotItem) * RENDER_SNAPSHOT_INITIAL_CAPACITY);
+        if (!snapshot->items) {
+            fprintf(stderr, "Failed to allocate memory for RenderSnapshot items.\n");
+            exit(EXIT_FAILURE);
+        }
+        snapshot->capacity = RENDER_SNAPSHOT_INITIAL_CAPACITY;
+    }
+    buffer->writing = 0;
+    buffer->reading = 1;
+    atomic_init(&buffer->ready, 2);
+}
+
+/**
+ * @brief Releases the item arrays of every slot.
+ *
+ * @param buffer Pointer to the RenderSnapshotBuffer to free.
+ */
+void render_snapshot_buffer_free(RenderSnapshotBuffer* buffer) {
+    for (int i = 0; i < RENDER_SNAPSHOT_SLOTS; i++) free(buffer->slots[i].items);
+    *buffer = (RenderSnapshotBuffer){0};
+}
+
+/**
+ * @brief Empties the simulation's slot and returns it for the next snapshot. Simulation side only.
+ *
+ * @param buffer Pointer to the RenderSnapshotBuffer.
+ * @return The snapshot to fill before render_snapshot_publish().
+ */
+RenderSnapshot* render_snapshot_begin(RenderSnapshotBuffer* buffer) {
+    RenderSnapshot* snapshot = &buffer->slots[buffer->writing];
+    snapshot->length = 0;
+    return snapshot;
+}
+
+/**
+ * @brief Returns true when the item's scaled box overlaps the window at either of its
+ * two ticks, or anywhere in between, so every interpolated position is covered.
+ */
+static bool item_on_screen(const RenderSnapshotItem* item) {
+    const float half_width = (float)item->width / 2;
+    const float half_height = (float)item->height / 2;
+    return MIN(item->previous_x, item->x) - half_width < WINDOW_WIDTH
+        && MAX(item->previous_x, item->x) + half_width > 0
+        && MIN(item->previous_y, item->y) - half_height < WINDOW_HEIGHT
+        && MAX(item->previous_y, item->y) + half_height > 0;
+}
+
+/**
+ * @brief Appends an item, growing the array by doubling.
+ *
+ * Items entirely outside WINDOW_WIDTH x WINDOW_HEIGHT are skipped, so sprites off the
+ * screen cost the renderer nothing.
+ *
+ * @param snapshot Snapshot returned by render_snapshot_begin().
+ * @param item Sprite to draw.
+ */
+void render_snapshot_add(RenderSnapshot* snapshot, RenderSnapshotItem item) {
+    if (!item_on_screen(&item)) return;
+    if (snapshot->length == snapshot->capacity) {
+        RenderSnapshotItem* items = realloc(snapshot->items, sizeof(RenderSnapshotItem) * snapshot->capacity * 2);
+        if (!items) {
+            fprintf(stderr, "Failed to allocate memory for RenderSnapshot items.\n");
+            exit(EXIT_FAILURE);
+        }
+        snapshot->items = items;
+        snapshot->capacity *= 2;
+    }
+    snapshot->items[snapshot->length++] = item;
+}
+
+/**
+ * @brief Makes the simulation's slot the latest snapshot and takes the previous latest
+ * one back for writing. Simulation side only.
+ *
+ * A snapshot the renderer never took is simply overwritten by the next one.
+ *
+ * @param buffer Pointer to the RenderSnapshotBuffer.
+ * @param tick Simulation tick the snapshot shows.
+ * @param tick_counter Performance counter value at which that tick was due.
+ */
+void render_snapshot_publish(RenderSnapshotBuffer* buffer, Uint32 tick, Uint64 tick_counter) {
+    RenderSnapshot* snapshot = &buffer->slots[buffer->writing];
+    snapshot->tick = tick;
+    snapshot->tick_counter = tick_counter;
+    const int previous = atomic_exchange_explicit(&buffer->ready, buffer->writing | RENDER_SNAPSHOT_FRESH, memory_order_acq_rel);
+    buffer->writing = previous & ~RENDER_SNAPSHOT_FRESH;
+}
+
+/**
+ * @brief Returns the latest snapshot. Renderer side only.
+ *
+ * When nothing was published since the last call, the snapshot drawn last time is
+ * returned again. It stays valid until the next call.
+ *
+ * @param buffer Pointer to the RenderSnapshotBuffer.
+ * @return The snapshot to draw.
+ */
+const RenderSnapshot* render_snapshot_acquire(RenderSnapshotBuffer* buffer) {
+    if (atomic_load_explicit(&buffer->ready, memory_order_relaxed) & RENDER_SNAPSHOT_FRESH) {
+        const int latest = atomic_exchange_explicit(&buffer->ready, buffer->reading, memory_order_acq_rel);
+        buffer->reading = latest & ~RENDER_SNAPSHOT_FRESH;
+    }
+    return &buffer->slots[buffer->reading];
+}
+
+/**
+ * @brief Queues every item of a snapshot into the draw list, centered on its
+ * interpolated position and snapped to whole pixels.
+ *
+ * @param snapshot Snapshot returned by render_snapshot_acquire().
+ * @param batch RenderBatch collecting the frame's quads.
+ * @param alpha Fraction of a tick elapsed since the snapshot's tick, in [0, 1].
+ */
+void render_snapshot_submit(const RenderSnapshot* snapshot, RenderBatch* batch, float alpha) {
+    for (size_t i = 0; i < snapshot->length; i++) {
+        const RenderSnapshotItem* item = &snapshot->items[i];
+        const float x = item->previous_x + (item->x - item->previous_x) * alpha;
+        const float y = item->previous_y + (item->y - item->previous_y) * alpha;
+        SDL_FRect sprite_rect = {
+            (float)((int)roundf(x) - item->width / 2),
+            (float)((int)roundf(y) - item->height / 2),
+            (float)item->width,
+            (float)item->height
+        };
+        render_batch_submit(batch, item->texture, item->source, &sprite_rect, item->layer);
+    }
+}
@@ -0,0 +1,155 @@
+#include "game.h"
+
+/**
+ * @brief Reads the arrow keys into an input bitmask.
+ */
+InputState input_read_keyboard(void) {
+    const Uint8* keystates = SDL_GetKeyboardState(NULL);
+    InputState input = 0;
+    if (keystates[SDL_SCANCODE_LEFT]) input |= INPUT_LEFT;
+    if (keystates[SDL_SCANCODE_RIGHT]) input |= INPUT_RIGHT;
+    if (keystates[SDL_SCANCODE_UP]) input |= INPUT_UP;
+    if (keystates[SDL_SCANCODE_DOWN]) input |= INPUT_DOWN;
+    return input;
+}
+
+/**
+ * @brief Appends a run, growing the array by doubling.
+ */
+static void push_run(Replay* replay, ReplayRun run) {
+    if (replay->length == replay->capacity) {
+        const size_t capacity = replay->capacity ? replay->capacity * 2 : REPLAY_INITIAL_CAPACITY;
+        ReplayRun* runs = realloc(replay->runs, capacity * sizeof(*runs));
+        if (!runs) {
+            fprintf(stderr, "Failed to allocate memory for the replay.\n");
+            exit(EXIT_FAILURE);
+        }
+        replay->runs = runs;
+        replay->capacity = capacity;
+    }
+    replay->runs[replay->length++] = run;
+}
+
+/**
+ * @brief Prepares an empty replay.
+ *
+ * @param replay Pointer to the Replay to initialize.
+ * @param mode REPLAY_RECORD to capture the session's input, REPLAY_OFF to only carry the seed.
+ * @param seed Seed of the session's Rng.
+ */
+void replay_init(Replay* replay, ReplayMode mode, Uint64 seed) {
+    *replay = (Replay){0};
+    replay->mode = mode;
+    replay->seed = seed;
+}
+
+/**
+ * @brief Loads a recorded session for playback.
+ *
+ * @param replay Pointer to the Replay to fill; it is left in REPLAY_PLAYBACK mode.
+ * @param path File written by replay_save().
+ * @return false if the file is missing, truncated or from another version.
+ */
+bool replay_load(Replay* replay, const char* path) {
+    replay_init(replay, REPLAY_PLAYBACK, 0);
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Failed to open replay %s\n", path);
+        return false;
+    }
+    ReplayHeader header;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == REPLAY_MAGIC && header.version == REPLAY_VERSION;
+    Uint32 tick_count = 0;
+    for (Uint32 i = 0; valid && i < header.run_count; i++) {
+        ReplayRun run;
+        valid = fread(&run.ticks, sizeof(run.ticks), 1, file) == 1 && fread(&run.input, sizeof(run.input), 1, file) == 1;
+        if (valid) {
+            push_run(replay, run);
+            tick_count += run.ticks;
+        }
+    }
+    fclose(file);
+    if (!valid || tick_count != header.tick_count) {
+        fprintf(stderr, "Invalid or outdated replay %s\n", path);
+        replay_free(replay);
+        return false;
+    }
+    replay->seed = header.seed;
+    replay->tick_count = header.tick_count;
+    return true;
+}
+
+/**
+ * @brief Writes the recorded session: the seed followed by the input runs.
+ *
+ * @param replay Pointer to the recorded Replay.
+ * @param path Destination file.
+ * @return false if the file could not be written.
+ */
+bool replay_save(const Replay* replay, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to create replay %s\n", path);
+        return false;
+    }
+    const ReplayHeader header = { REPLAY_MAGIC, REPLAY_VERSION, replay->seed, replay->tick_count, (Uint32)replay->length };
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; written && i < replay->length; i++) {
+        written = fwrite(&replay->runs[i].ticks, sizeof(replay->runs[i].ticks), 1, file) == 1
+            && fwrite(&replay->runs[i].input, sizeof(replay->runs[i].input), 1, file) == 1;
+    }
+    if (fclose(file) != 0) written = false;
+    if (!written) fprintf(stderr, "Failed to write replay %s\n", path);
+    return written;
+}
+
+/**
+ * @brief Picks the input for the next simulation tick.
+ *
+ * When recording, the live input is appended to the replay and used as is. During
+ * playback the live input is ignored and the recorded one is returned instead.
+ *
+ * @param replay Pointer to the Replay.
+ * @param live Input sampled from the keyboard for this tick.
+ * @param input Output for the input the tick must use.
+ * @return false once a played back session has run out of ticks.
+ */
+bool replay_next_input(Replay* replay, InputState live, InputState* input) {
+    switch (replay->mode) {
+        case REPLAY_OFF:
+            *input = live;
+            return true;
+        case REPLAY_RECORD:
+            if (replay->length > 0 && replay->runs[replay->length - 1].input == live) {
+                replay->runs[replay->length - 1].ticks++;
+            } else {
+                push_run(replay, (ReplayRun){ 1, live });
+            }
+            replay->tick_count++;
+            *input = live;
+            return true;
+        case REPLAY_PLAYBACK:
+            while (replay->cursor < replay->length && replay->cursor_tick == replay->runs[replay->cursor].ticks) {
+                replay->cursor++;
+                replay->cursor_tick = 0;
+            }
+            if (replay->cursor == replay->length) return false;
+            replay->cursor_tick++;
+            *input = replay->runs[replay->cursor].input;
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Frees the recorded runs.
+ *
+ * @param replay Pointer to the Replay.
+ */
+void replay_free(Replay* replay) {
+    free(replay->runs);
+    replay->runs = NULL;
+    replay->length = 0;
+    replay->capacity = 0;
+}
@@ -19,19 +19,7 @@ Sprite create_ring(SDL_Renderer* renderer) {
         "assets/sprites/ring/ring_4.png"
     };
     size_t frames_length = sizeof(frame_paths) / sizeof(frame_paths[0]);
-    Frames frames = {
-        frame_paths,
-        frames_length,
-        RING_FRAME_DELAY,
-        malloc(sizeof(SDL_Texture*) * frames_length),
-        malloc(sizeof(int) * frames_length),
-        malloc(sizeof(int) * frames_length)
-    };
-    if (!frames.texture || !frames.widths || !frames.heights) {
-        fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
-        exit(EXIT_FAILURE);
-    }
-    load_texture(&frames, renderer);
+    Frames frames = asset_cache_acquire_frames(frame_paths, frames_length, RING_FRAME_DELAY, renderer);
     return initialize_ring(frames);
 }
 
@@ -48,18 +36,18 @@ Sprite create_ring(SDL_Renderer* renderer) {
  */
 Sprite initialize_ring(Frames frames) {
     Sprite ring;
+    ring.components = create_sprite_components(frames);
     ring.type = RING;
-    ring.effects.effect_type = RING_EFFECT;
-    ring.effects.ring_delta = RING_DELTA;
+    ring.components->effects.effect_type = RING_EFFECT;
+    ring.components->effects.ring_delta = RING_DELTA;
     ring.scale = RING_ZOOM_SCALE;
     ring.current_frame = RING_CURRENT_FRAME;
     ring.width = frames.widths[ring.current_frame];
     ring.height = frames.heights[ring.current_frame];
     ring.x = WINDOW_WIDTH;
-    ring.y = get_random_y_position(&ring);
+    ring.y = get_vertical_center_offset(&ring); // Rolled again for every spawn
     ring.speed = RING_SPEED;
     ring.collision_state = COLLISION_NONE;
     ring.animation_accumulator = 0;
-    ring.frames = frames;
     return ring;
 }
@@ -0,0 +1,70 @@
+#include "game.h"
+
+/**
+ * @brief SplitMix64 step, used to spread a seed over the generator state.
+ */
+static Uint64 splitmix64(Uint64* x) {
+    Uint64 z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static Uint32 rotate_left(Uint32 x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+/**
+ * @brief Seeds the generator. Any seed, including 0, yields a valid non-zero state.
+ *
+ * @param rng Pointer to the Rng to seed.
+ * @param seed Seed value; the same seed always produces the same sequence.
+ */
+void rng_seed(Rng* rng, Uint64 seed) {
+    const Uint64 low = splitmix64(&seed);
+    const Uint64 high = splitmix64(&seed);
+    rng->state[0] = (Uint32)low;
+    rng->state[1] = (Uint32)(low >> 32);
+    rng->state[2] = (Uint32)high;
+    rng->state[3] = (Uint32)(high >> 32);
+}
+
+/**
+ * @brief Returns the next 32 random bits.
+ *
+ * @param rng Pointer to the Rng.
+ */
+Uint32 rng_next(Rng* rng) {
+    Uint32* s = rng->state;
+    const Uint32 result = rotate_left(s[1] * 5, 7) * 9;
+    const Uint32 t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotate_left(s[3], 11);
+    return result;
+}
+
+/**
+ * @brief Returns a number in [0, bound) without the bias of `% bound`.
+ *
+ * Multiply-shift mapping with rejection of the few values that would skew the result.
+ *
+ * @param rng Pointer to the Rng.
+ * @param bound Exclusive upper bound; 0 returns 0.
+ */
+Uint32 rng_below(Rng* rng, Uint32 bound) {
+    if (bound == 0) return 0;
+    Uint64 product = (Uint64)rng_next(rng) * bound;
+    Uint32 low = (Uint32)product;
+    if (low < bound) {
+        const Uint32 threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            product = (Uint64)rng_next(rng) * bound;
+            low = (Uint32)product;
+        }
+    }
+    return (Uint32)(product >> 32);
+}
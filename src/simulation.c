@@ -0,0 +1,148 @@
+#include "game.h"
+
+/**
+ * @brief Records the world as it stands after the last tick and makes it the latest snapshot.
+ */
+static void publish_snapshot(Simulation* simulation, Uint64 tick_counter) {
+    RenderSnapshot* snapshot = render_snapshot_begin(&simulation->snapshots);
+    world_snapshot(simulation->world, snapshot);
+    render_snapshot_publish(&simulation->snapshots, simulation->world->tick, tick_counter);
+}
+
+/**
+ * @brief Simulation thread loop: runs the ticks that are due, then sleeps until the next one.
+ */
+static int simulation_thread_main(void* data) {
+    Simulation* simulation = data;
+    PROFILE_THREAD("simulation");
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    while (atomic_load_explicit(&simulation->running, memory_order_acquire)) {
+        if (!simulation_update(simulation)) break;
+        const Uint64 remaining = simulation->tick_counts - MIN(simulation->accumulator, simulation->tick_counts);
+        SDL_Delay((Uint32)MAX(remaining * 1000 / frequency, 1));
+    }
+    return 0;
+}
+
+/**
+ * @brief Prepares the snapshot buffer and publishes the world's initial state.
+ *
+ * @param simulation Pointer to the Simulation to initialize.
+ * @param world World to advance; it must outlive the simulation.
+ */
+void simulation_init(Simulation* simulation, GameWorld* world) {
+    simulation->world = world;
+    simulation->thread = NULL;
+    simulation->tick_counts = SDL_GetPerformanceFrequency() * SIMULATION_TICK_MS / 1000;
+    simulation->last_counter = SDL_GetPerformanceCounter();
+    simulation->accumulator = 0;
+    atomic_init(&simulation->input, 0);
+    atomic_init(&simulation->running, false);
+    atomic_init(&simulation->finished, false);
+    render_snapshot_buffer_init(&simulation->snapshots);
+    publish_snapshot(simulation, simulation->last_counter);
+}
+
+/**
+ * @brief Starts the simulation thread.
+ *
+ * If the thread cannot be created, the caller keeps running simulation_update() once
+ * per frame, as the game loop did before the simulation had a thread.
+ *
+ * @param simulation Pointer to the Simulation.
+ * @return true if the simulation thread is running.
+ */
+bool simulation_start(Simulation* simulation) {
+    atomic_store(&simulation->running, true);
+    simulation->last_counter = SDL_GetPerformanceCounter();
+    simulation->thread = SDL_CreateThread(simulation_thread_main, "simulation", simulation);
+    if (!simulation->thread) {
+        printf("Simulation thread unavailable, ticks run on the render thread: %s\n", SDL_GetError());
+        atomic_store(&simulation->running, false);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hands the buttons currently held to the simulation. Main thread only.
+ *
+ * @param simulation Pointer to the Simulation.
+ * @param input Buttons read from the keyboard this frame.
+ */
+void simulation_set_input(Simulation* simulation, InputState input) {
+    atomic_store_explicit(&simulation->input, input, memory_order_relaxed);
+}
+
+/**
+ * @brief Runs as many fixed ticks as the elapsed wall time covers and publishes a
+ * snapshot of the result.
+ *
+ * After a long stall (window drag, breakpoint) the backlog is dropped instead of
+ * spiralling to catch up. Each batch of ticks opens one audio frame.
+ *
+ * @param simulation Pointer to the Simulation.
+ * @return false once a played back session is over.
+ */
+bool simulation_update(Simulation* simulation) {
+    const Uint64 counter = SDL_GetPerformanceCounter();
+    simulation->accumulator += counter - simulation->last_counter;
+    simulation->last_counter = counter;
+    if (simulation->accumulator > simulation->tick_counts * MAX_TICKS_PER_FRAME)
+        simulation->accumulator = simulation->tick_counts * MAX_TICKS_PER_FRAME;
+    if (simulation->accumulator < simulation->tick_counts) return true;
+
+    audio_begin_frame();
+    const InputState input = atomic_load_explicit(&simulation->input, memory_order_relaxed);
+    while (simulation->accumulator >= simulation->tick_counts) {
+        if (!world_tick(simulation->world, input)) {
+            // The replay is over
+            atomic_store_explicit(&simulation->finished, true, memory_order_release);
+            return false;
+        }
+        simulation->accumulator -= simulation->tick_counts;
+    }
+    publish_snapshot(simulation, counter - simulation->accumulator);
+    return true;
+}
+
+/**
+ * @brief Tells whether a played back session has run out of input.
+ */
+bool simulation_finished(Simulation* simulation) {
+    return atomic_load_explicit(&simulation->finished, memory_order_acquire);
+}
+
+/**
+ * @brief Fraction of a tick elapsed since the snapshot's tick was due, in [0, 1].
+ *
+ * @param simulation Pointer to the Simulation.
+ * @param snapshot Snapshot about to be drawn.
+ */
+float simulation_alpha(const Simulation* simulation, const RenderSnapshot* snapshot) {
+    const Uint64 counter = SDL_GetPerformanceCounter();
+    if (counter <= snapshot->tick_counter) return 0.0f;
+    return MIN((float)(counter - snapshot->tick_counter) / (float)simulation->tick_counts, 1.0f);
+}
+
+/**
+ * @brief Stops and joins the simulation thread. The world is the caller's again afterwards.
+ *
+ * @param simulation Pointer to the Simulation.
+ */
+void simulation_stop(Simulation* simulation) {
+    if (!simulation->thread) return;
+    atomic_store_explicit(&simulation->running, false, memory_order_release);
+    SDL_WaitThread(simulation->thread, NULL);
+    simulation->thread = NULL;
+}
+
+/**
+ * @brief Stops the thread if needed and releases the snapshot buffer.
+ *
+ * @param simulation Pointer to the Simulation.
+ */
+void simulation_free(Simulation* simulation) {
+    simulation_stop(simulation);
+    render_snapshot_buffer_free(&simulation->snapshots);
+}
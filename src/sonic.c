@@ -18,19 +18,7 @@ Sprite create_sonic(SDL_Renderer* renderer) {
         "assets/sprites/sonic/sonic_4.png"
     };
     size_t frames_length = sizeof(frame_paths) / sizeof(frame_paths[0]);
-    Frames frames = {
-        frame_paths,
-        frames_length,
-        SONIC_FRAME_DELAY,
-        malloc(sizeof(SDL_Texture*) * frames_length),
-        malloc(sizeof(int) * frames_length),
-        malloc(sizeof(int) * frames_length)
-    };
-    if (!frames.texture || !frames.widths || !frames.heights) {
-        fprintf(stderr, "Failed to allocate memory for Frames resources.\n");
-        exit(EXIT_FAILURE);
-    }
-    load_texture(&frames, renderer);
+    Frames frames = asset_cache_acquire_frames(frame_paths, frames_length, SONIC_FRAME_DELAY, renderer);
     return initialize_sonic(frames);
 }
 
@@ -45,9 +33,10 @@ Sprite create_sonic(SDL_Renderer* renderer) {
  */
 Sprite initialize_sonic(Frames frames) {
     Sprite sonic;
+    sonic.components = create_sprite_components(frames);
     sonic.type = PLAYER;
-    sonic.life = SONIC_LIFE;
-    sonic.rings = SONIC_RINGS;
+    sonic.components->stats.life = SONIC_LIFE;
+    sonic.components->stats.rings = SONIC_RINGS;
     sonic.scale = SONIC_ZOOM_SCALE;
     sonic.current_frame = SONIC_CURRENT_FRAME;
     sonic.width = frames.widths[sonic.current_frame];
@@ -56,15 +45,14 @@ Sprite initialize_sonic(Frames frames) {
     sonic.y = get_vertical_center_offset(&sonic);
     sonic.speed = SONIC_SPEED;
     sonic.collision_state = COLLISION_NONE;
-    sonic.hover_amplitude = 1.5f;
-    sonic.hover_frequency = 0.006f;
-    sonic.hover_start_time = SDL_GetTicks();
-    sonic.velocity_x = 0;
-    sonic.velocity_y = 0;
-    sonic.acceleration = 0.4f;
-    sonic.friction = 0.95f;
+    sonic.components->physics.hover_amplitude = 1.5f;
+    sonic.components->physics.hover_frequency = 0.006f;
+    sonic.components->physics.hover_elapsed = 0;
+    sonic.components->physics.velocity_x = 0;
+    sonic.components->physics.velocity_y = 0;
+    sonic.components->physics.acceleration = 0.4f;
+    sonic.components->physics.friction = 0.95f;
     sonic.animation_accumulator = 0;
-    sonic.frames = frames;
     return sonic;
 }
 
@@ -73,14 +61,16 @@ Sprite initialize_sonic(Frames frames) {
  *
  * This function uses the time scale factor to update the Sonic sprite's
  * velocity and position by considering player interactions and applying friction.
+ * The input is passed in rather than read from the keyboard, so a recorded session
+ * can drive Sonic exactly as the player did.
  *
  * @param sonic A pointer to the Sprite structure representing Sonic.
+ * @param input Buttons held during this tick.
  * @param delta_time The time elapsed since the last frame, used to scale motion.
  */
-void sonic_motion(Sprite *sonic, Uint32 delta_time) {
-    const Uint8 *keystates = SDL_GetKeyboardState(NULL);
+void sonic_motion(Sprite *sonic, InputState input, Uint32 delta_time) {
     float time_scale_factor = get_time_scale_factor(delta_time);
-    watch_player_interactions(sonic, keystates);
+    watch_player_interactions(sonic, input, delta_time);
     apply_friction(sonic, time_scale_factor);
     update_position(sonic, time_scale_factor);
     check_boundary(sonic);
@@ -90,21 +80,23 @@ void sonic_motion(Sprite *sonic, Uint32 delta_time) {
 /**
  * @brief Processes player input and updates Sonic's velocity or hover effect.
  *
- * This function handles keyboard input from the player and modifies Sonic's velocity
+ * This function handles the player's input and modifies Sonic's velocity
  * based on the arrow keys pressed. If no arrow keys are pressed, it triggers a hover
  * effect using a sine wave oscillation to simulate idle floating.
  *
  * @param sonic A Pointer to the Sprite structure representing Sonic.
- * @param keystates The SDL keyboard state array. Used to detect arrow key presses.
+ * @param input Buttons held during this tick.
+ * @param delta_time The time elapsed since the last frame, in milliseconds.
  */
-void watch_player_interactions(Sprite *sonic, const Uint8 *keystates) {
-    if (keystates[SDL_SCANCODE_LEFT]) sonic->velocity_x -= sonic->acceleration;
-    if (keystates[SDL_SCANCODE_RIGHT]) sonic->velocity_x += sonic->acceleration;
-    if (keystates[SDL_SCANCODE_UP]) sonic->velocity_y -= sonic->acceleration;
-    if (keystates[SDL_SCANCODE_DOWN]) sonic->velocity_y += sonic->acceleration;
-    bool arrow_pressed = is_arrow_pressed(keystates);
-    if (arrow_pressed) sonic->hover_start_time = SDL_GetTicks();
-    if (!arrow_pressed) apply_hover_effect(sonic);
+void watch_player_interactions(Sprite *sonic, InputState input, Uint32 delta_time) {
+    PlayerPhysics* physics = &sonic->components->physics;
+    if (input & INPUT_LEFT) physics->velocity_x -= physics->acceleration;
+    if (input & INPUT_RIGHT) physics->velocity_x += physics->acceleration;
+    if (input & INPUT_UP) physics->velocity_y -= physics->acceleration;
+    if (input & INPUT_DOWN) physics->velocity_y += physics->acceleration;
+    bool arrow_pressed = is_arrow_pressed(input);
+    if (arrow_pressed) physics->hover_elapsed = 0;
+    if (!arrow_pressed) apply_hover_effect(sonic, delta_time);
 }
 
 /**
@@ -112,31 +104,27 @@ void watch_player_interactions(Sprite *sonic, const Uint8 *keystates) {
  *
  * This creates a smooth vertical oscillation using a sine wave, centered around Sonic's
  * starting Y position. The oscillation speed and amplitude are controlled by
- * `hover_frequency` and `hover_amplitude`.
+ * `hover_frequency` and `hover_amplitude`. The phase follows simulated time since
+ * the last arrow key press, not the wall clock.
  *
  * @param sonic Pointer to the Sprite structure representing Sonic.
+ * @param delta_time The time elapsed since the last frame, in milliseconds.
  */
-void apply_hover_effect(Sprite *sonic) {
-    Uint32 current_time = SDL_GetTicks();
-    Uint32 elapsed_time = current_time - sonic->hover_start_time;
-    float oscillation = sinf(elapsed_time * sonic->hover_frequency) * sonic->hover_amplitude;
+void apply_hover_effect(Sprite *sonic, Uint32 delta_time) {
+    PlayerPhysics* physics = &sonic->components->physics;
+    physics->hover_elapsed += delta_time;
+    float oscillation = sinf(physics->hover_elapsed * physics->hover_frequency) * physics->hover_amplitude;
     sonic->y += oscillation;
 }
 
 /**
  * @brief Checks if any arrow keys (Left/Right/Up/Down) are currently pressed.
  *
- * This utility function scans the keyboard state array for the four arrow keys
- * and returns `true` if any of them are pressed.
- *
- * @param keystates The SDL keyboard state array.
+ * @param input Buttons held during this tick.
  * @return `true` if any arrow key is pressed, `false` otherwise.
  */
-bool is_arrow_pressed(const Uint8 *keystates) {
-    return keystates[SDL_SCANCODE_LEFT] || 
-        keystates[SDL_SCANCODE_RIGHT] ||
-        keystates[SDL_SCANCODE_UP] ||
-        keystates[SDL_SCANCODE_DOWN];
+bool is_arrow_pressed(InputState input) {
+    return (input & (INPUT_LEFT | INPUT_RIGHT | INPUT_UP | INPUT_DOWN)) != 0;
 }
 
 /**
@@ -146,14 +134,16 @@ bool is_arrow_pressed(const Uint8 *keystates) {
  * The friction factor is scaled by `time_scale_factor` to ensure consistent decay
  * across different frame rates.
  * It uses `pow(friction, time_scale_factor)` to apply frame-rate-independent decay.
+ * At the fixed simulation tick the scale factor is exactly 1, so the power is skipped.
  *
  * @param sonic Pointer to the Sprite structure representing Sonic.
  * @param time_scale_factor Frame-rate scaling factor.
  */
 void apply_friction(Sprite *sonic, float time_scale_factor) {
-    float friction_factor = powf(sonic->friction, time_scale_factor);
-    sonic->velocity_x *= friction_factor;
-    sonic->velocity_y *= friction_factor;
+    PlayerPhysics* physics = &sonic->components->physics;
+    float friction_factor = time_scale_factor == 1.0f ? physics->friction : powf(physics->friction, time_scale_factor);
+    physics->velocity_x *= friction_factor;
+    physics->velocity_y *= friction_factor;
 }
 
 /**
@@ -166,8 +156,9 @@ void apply_friction(Sprite *sonic, float time_scale_factor) {
  * @param time_scale_factor Frame-rate scaling factor.
  */
 void update_position(Sprite *sonic, float time_scale_factor) {
-    sonic->x += sonic->velocity_x * time_scale_factor;
-    sonic->y += sonic->velocity_y * time_scale_factor;
+    const PlayerPhysics* physics = &sonic->components->physics;
+    sonic->x += physics->velocity_x * time_scale_factor;
+    sonic->y += physics->velocity_y * time_scale_factor;
 }
 
 /**
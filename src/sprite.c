@@ -3,10 +3,11 @@
 /**
  * @brief Loads textures for each frame in the Frames structure.
  *
- * This function iterates over the frame paths in the Frames structure,
- * loads each image as an SDL_Surface, retrieves its dimensions, and
- * creates an SDL_Texture from it. The textures and their dimensions
- * are stored in the Frames structure.
+ * This function iterates over the frame paths in the Frames structure and
+ * takes each texture from the asset cache, which decodes every image only once
+ * and shares it between all the sprites using it. The textures, their source
+ * rectangles (the image's region when it is packed in an atlas) and their
+ * dimensions are stored in the Frames structure.
  *
  * @param frames A pointer to a Frames structure containing paths and
  *        storage for textures and their dimensions.
@@ -14,20 +15,28 @@
  */
 void load_texture(Frames* frames, SDL_Renderer* renderer) {
     for (size_t i = 0; i < frames->length; i++) {
-        SDL_Surface* surface = IMG_Load(frames->paths[i]);
-        if (!surface) {
-            printf("Failed to load %s: %s\n", frames->paths[i], IMG_GetError());
-            exit(EXIT_FAILURE);
-        }
-        frames->widths[i] = surface->w;
-        frames->heights[i] = surface->h;
-        SDL_FreeSurface(surface);
-        frames->texture[i] = IMG_LoadTexture(renderer, frames->paths[i]);
-        if (!frames->texture[i]) {
-            printf("Texture creation failed: %s\n", SDL_GetError());
-            exit(EXIT_FAILURE);
-        }
+        frames->texture[i] = asset_cache_acquire_texture(frames->paths[i], renderer, &frames->sources[i]);
+        if (!frames->texture[i]) exit(EXIT_FAILURE);
+        frames->widths[i] = frames->sources[i].w;
+        frames->heights[i] = frames->sources[i].h;
+    }
+}
+
+/**
+ * @brief Allocates the cold components of a new sprite, with no effects and zeroed
+ * player components.
+ *
+ * @param frames Frames the sprite is drawn with.
+ * @return The components, released with free_sprite_frames().
+ */
+SpriteComponents* create_sprite_components(Frames frames) {
+    SpriteComponents* components = calloc(1, sizeof(SpriteComponents));
+    if (!components) {
+        fprintf(stderr, "Failed to allocate memory for SpriteComponents.\n");
+        exit(EXIT_FAILURE);
     }
+    components->frames = frames;
+    return components;
 }
 
 /**
@@ -37,17 +46,18 @@ void load_texture(Frames* frames, SDL_Renderer* renderer) {
  * elapsed time between frame changes. It advances the animation frame when the
  * accumulated time exceeds the frame delay duration.
  * It also updates dimensions when frame actually changes.
+ * Callers count the sprites they animate in STAT_SPRITES_ANIMATED, once per pass.
  * 
  * @param sprite Pointer to Sprite with animation properties
  * @param delta_time Milliseconds elapsed since last update
  */
 void sprite_animation(Sprite *sprite, Uint32 delta_time) {
     sprite->animation_accumulator += delta_time;
-    while (sprite->animation_accumulator >= sprite->frames.delay) {
-        sprite->current_frame = (sprite->current_frame + 1) % sprite->frames.length;
-        sprite->animation_accumulator -= sprite->frames.delay;
-        sprite->width = sprite->frames.widths[sprite->current_frame];
-        sprite->height = sprite->frames.heights[sprite->current_frame];
+    while (sprite->animation_accumulator >= sprite->components->frames.delay) {
+        sprite->current_frame = (Uint16)((sprite->current_frame + 1) % sprite->components->frames.length);
+        sprite->animation_accumulator -= sprite->components->frames.delay;
+        sprite->width = sprite->components->frames.widths[sprite->current_frame];
+        sprite->height = sprite->components->frames.heights[sprite->current_frame];
     }
 }
 
@@ -60,14 +70,15 @@ void sprite_animation(Sprite *sprite, Uint32 delta_time) {
  * a new random vertical position. The sprite's boundaries are updated accordingly.
  *
  * @param sprite Pointer to the Sprite whose position and boundaries are to be updated.
+ * @param rng Generator of the world the sprite lives in.
  * @param delta_time The time elapsed since the last update, in milliseconds.
  */
-void sprite_motion(Sprite *sprite, Uint32 delta_time) {
+void sprite_motion(Sprite *sprite, Rng* rng, Uint32 delta_time) {
     const float scaled_width = sprite->width * sprite->scale;
     sprite->x += sprite->speed * get_time_scale_factor(delta_time);
     if (sprite->x + (scaled_width / 2) < 0) {
         sprite->x = WINDOW_WIDTH + (scaled_width / 2);
-        sprite->y = get_random_y_position(sprite);
+        sprite->y = get_random_y_position(rng, sprite);
     }
     update_sprite_boundaries(sprite);
 }
@@ -92,8 +103,44 @@ void sprite_render(Sprite *sprite, SDL_Renderer* renderer) {
         scaled_width,
         scaled_height
     };
-    SDL_Texture* texture = sprite->frames.texture[sprite->current_frame];
-    SDL_RenderCopy(renderer, texture, NULL, &sprite_rect);
+    SDL_Texture* texture = sprite->components->frames.texture[sprite->current_frame];
+    SDL_RenderCopy(renderer, texture, &sprite->components->frames.sources[sprite->current_frame], &sprite_rect);
+    stats_add(STAT_RENDER_CALLS, 1);
+    stats_add(STAT_TEXTURE_SWITCHES, 1);
+}
+
+/**
+ * @brief Adds the sprite to a render snapshot instead of drawing it immediately.
+ *
+ * Records what sprite_render() would draw: the current frame, the scaled size and the
+ * positions at the previous and the current simulation tick, so the renderer can
+ * interpolate between them when the display rate differs from the tick rate.
+ *
+ * @param sprite Pointer to Sprite to draw
+ * @param snapshot RenderSnapshot being built for this tick
+ * @param layer Layer the sprite is drawn in
+ */
+void sprite_snapshot(const Sprite *sprite, RenderSnapshot* snapshot, RenderLayer layer) {
+    render_snapshot_add(snapshot, (RenderSnapshotItem){
+        sprite->components->frames.texture[sprite->current_frame],
+        &sprite->components->frames.sources[sprite->current_frame],
+        sprite->previous_x, sprite->previous_y, sprite->x, sprite->y,
+        (int)((float)sprite->width * sprite->scale), (int)((float)sprite->height * sprite->scale),
+        layer
+    });
+}
+
+/**
+ * @brief Remembers the current position as the start of the next interpolation step.
+ *
+ * Called before every simulation tick, and once after a sprite is created or teleported
+ * so it is not drawn sliding in from a stale position.
+ *
+ * @param sprite Pointer to Sprite to update
+ */
+void sprite_save_previous_position(Sprite *sprite) {
+    sprite->previous_x = sprite->x;
+    sprite->previous_y = sprite->y;
 }
 
 /**
@@ -102,12 +149,28 @@ void sprite_render(Sprite *sprite, SDL_Renderer* renderer) {
  * Accounts for centered positioning and scaled dimensions to ensure
  * the sprite never spawns partially off-screen.
  * 
+ * @param rng Generator of the world the sprite lives in
  * @param sprite Pointer to Sprite (uses base_width/base_height and scale)
  * @return Y-coordinate in safe range [half_height, WINDOW_HEIGHT - half_height]
  */
-int get_random_y_position(const Sprite* sprite) {
-    const int half_height = (int)(sprite->height * sprite->scale) / 2;
-    return half_height + rand() % (WINDOW_HEIGHT - 2 * half_height);
+int get_random_y_position(Rng* rng, const Sprite* sprite) {
+    return get_random_y_for_size(rng, sprite->height, sprite->scale);
+}
+
+/**
+ * @brief Generates a random position for a sprite of the given base height and scale.
+ *
+ * Same range as get_random_y_position(), for callers that keep the size
+ * outside of a Sprite (e.g., the EntityStore arrays).
+ *
+ * @param rng Generator of the world the sprite lives in.
+ * @param height Base height of the sprite in pixels.
+ * @param scale Zoom scale applied to the height.
+ * @return Y-coordinate in safe range [half_height, WINDOW_HEIGHT - half_height]
+ */
+int get_random_y_for_size(Rng* rng, int height, float scale) {
+    const int half_height = (int)((float)height * scale) / 2;
+    return half_height + (int)rng_below(rng, (Uint32)(WINDOW_HEIGHT - 2 * half_height));
 }
 
 /**
@@ -126,21 +189,20 @@ float get_vertical_center_offset(const Sprite* sprite) {
 }
 
 /**
- * @brief Frees the memory allocated for the textures of a sprite's frames.
+ * @brief Releases the sprite's reference to its shared frames, and its components.
  * 
- * This function iterates through the textures of a sprite's frames and 
- * destroys each texture using SDL_DestroyTexture. It then frees the memory 
- * allocated for the texture array and sets the pointer to NULL.
+ * The frames come from the asset cache and are shared by every sprite of the
+ * same archetype; their textures and arrays are only freed once the last
+ * sprite using them releases its reference. Call it once, on the sprite the
+ * components were created for, not on its copies.
  * 
- * @param sprite Pointer to the sprite whose frame textures need to be freed.
+ * @param sprite Pointer to the sprite whose frames need to be released.
  */
 void free_sprite_frames(Sprite *sprite) {
-    if (sprite->frames.texture) {
-        for (size_t i = 0; i < sprite->frames.length; i++)
-            if (sprite->frames.texture[i]) SDL_DestroyTexture(sprite->frames.texture[i]);
-        free(sprite->frames.texture);
-        sprite->frames.texture = NULL;
-    }
+    if (!sprite->components) return;
+    if (sprite->components->frames.texture) asset_cache_release_frames(&sprite->components->frames);
+    free(sprite->components);
+    sprite->components = NULL;
 }
 
 /**
@@ -223,6 +285,7 @@ void update_collision_states(Sprite *sonic, Sprite **sprites, size_t sprites_len
                 break;
         }
     }
+    stats_add(STAT_AABB_TESTS, (unsigned)sprites_length);
 }
 
 /**
@@ -257,7 +320,7 @@ void handle_collisions(Sprite *sonic, Sprite **sprites, size_t sprites_length) {
  * @param sonic Pointer to the player's sprite.
  */
 void handle_collision_enter(Sprite *sprite, Sprite *sonic) {
-    switch (sprite->effects.effect_type) {
+    switch (sprite->components->effects.effect_type) {
         case DAMAGE_EFFECT: apply_penalties(sprite, sonic); break;
         case RING_EFFECT: apply_bonus(sprite, sonic); break;
         case LIFE_EFFECT: apply_Life(sprite, sonic); break;
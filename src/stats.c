@@ -0,0 +1,212 @@
+#include "game.h"
+
+static const char* const stat_labels[STAT_COUNT] = {
+    #define STAT_ENTRY(id, label) [id] = label,
+    #include "stats_registry.def"
+    #undef STAT_ENTRY
+};
+
+static const char* const event_labels[EVENT_TYPE_COUNT] = {
+    [EVENT_LIFE_CHANGED] = "life",
+    [EVENT_SCORE_CHANGED] = "score",
+    [EVENT_RINGS_CHANGED] = "rings",
+    [EVENT_STAGE_CHANGED] = "stage",
+    [EVENT_MUSIC_PLAY] = "music",
+    [EVENT_SOUND_EFFECT] = "sfx",
+    [EVENT_STOP_AUDIO] = "stop audio",
+    [EVENT_BACKGROUND_CHANGE] = "background",
+    [EVENT_SCREEN_SHAKE] = "shake",
+    [EVENT_GAME_OVER] = "game over",
+};
+
+/*
+ * 3x5 pixel font. Each octal digit is one row, top to bottom, most significant bit on
+ * the left. Characters outside the table are drawn as blanks.
+ */
+static const Uint16 font_digits[10] = {
+    075557, 026227, 071747, 071717, 055711, 074717, 074757, 071111, 075757, 075717
+};
+static const Uint16 font_letters[26] = {
+    025755, 065656, 034443, 065556, 074647, 074644, 034553, 055755, 072227, 011152, 055655, 044447, 057755,
+    065555, 025552, 065644, 025563, 065655, 034216, 072222, 055557, 055552, 055775, 055255, 055222, 071247
+};
+
+static FrameStats current_stats;
+static FrameStatsSnapshot last_stats;
+static float frame_history[STATS_GRAPH_LENGTH];
+static size_t frame_history_next = 0;
+static Uint64 last_frame_counter = 0;
+static bool overlay_visible = false;
+static SDL_Rect overlay_rects[STATS_MAX_RECTS];
+static int overlay_rects_length = 0;
+
+/**
+ * @brief Adds to one of the per-frame counters.
+ *
+ * @param counter Counter to bump.
+ * @param amount Value to add.
+ */
+void stats_add(StatCounter counter, unsigned amount) {
+    atomic_fetch_add_explicit(&current_stats.counters[counter], amount, memory_order_relaxed);
+}
+
+/**
+ * @brief Counts an event accepted by the queue.
+ */
+void stats_event_queued(GameEventType type) {
+    atomic_fetch_add_explicit(&current_stats.events_queued[type], 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Counts an event the queue had no room for.
+ */
+void stats_event_dropped(GameEventType type) {
+    atomic_fetch_add_explicit(&current_stats.events_dropped[type], 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Counts events handed to subscribers, after coalescing.
+ */
+void stats_events_dispatched(GameEventType type, unsigned amount) {
+    atomic_fetch_add_explicit(&current_stats.events_dispatched[type], amount, memory_order_relaxed);
+}
+
+/**
+ * @brief Closes the frame: snapshots and resets every counter and records the frame time.
+ *
+ * Call once per frame on the main thread, after present.
+ */
+void stats_end_frame(void) {
+    for (size_t i = 0; i < STAT_COUNT; i++)
+        last_stats.counters[i] = atomic_exchange_explicit(&current_stats.counters[i], 0, memory_order_relaxed);
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        last_stats.events_queued[i] = atomic_exchange_explicit(&current_stats.events_queued[i], 0, memory_order_relaxed);
+        last_stats.events_dropped[i] = atomic_exchange_explicit(&current_stats.events_dropped[i], 0, memory_order_relaxed);
+        last_stats.events_dispatched[i] = atomic_exchange_explicit(&current_stats.events_dispatched[i], 0, memory_order_relaxed);
+    }
+    const Uint64 now = SDL_GetPerformanceCounter();
+    last_stats.frame_ms = last_frame_counter
+        ? (float)((double)(now - last_frame_counter) * 1000.0 / (double)SDL_GetPerformanceFrequency())
+        : 0.0f;
+    last_frame_counter = now;
+    frame_history[frame_history_next] = last_stats.frame_ms;
+    frame_history_next = (frame_history_next + 1) % STATS_GRAPH_LENGTH;
+}
+
+/**
+ * @brief Counters of the last finished frame.
+ */
+const FrameStatsSnapshot* stats_last_frame(void) {
+    return &last_stats;
+}
+
+/**
+ * @brief Shows or hides the on-screen stats overlay.
+ */
+void stats_toggle_overlay(void) {
+    overlay_visible = !overlay_visible;
+}
+
+static void push_rect(int x, int y, int w, int h) {
+    if (overlay_rects_length == STATS_MAX_RECTS) return;
+    overlay_rects[overlay_rects_length++] = (SDL_Rect){ x, y, w, h };
+}
+
+/**
+ * @brief Draws every queued rectangle in one color with a single call.
+ */
+static void flush_rects(SDL_Renderer* renderer, Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+    if (overlay_rects_length == 0) return;
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+    SDL_RenderFillRects(renderer, overlay_rects, overlay_rects_length);
+    overlay_rects_length = 0;
+}
+
+static Uint16 glyph_for(char c) {
+    if (c >= '0' && c <= '9') return font_digits[c - '0'];
+    if (c >= 'a' && c <= 'z') return font_letters[c - 'a'];
+    if (c >= 'A' && c <= 'Z') return font_letters[c - 'A'];
+    switch (c) {
+        case ':': return 002020;
+        case '.': return 000002;
+        case '/': return 011244;
+        case '-': return 000700;
+        case '%': return 051245;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Queues the pixels of a line of text, merging horizontal runs within a glyph row.
+ */
+static void push_text(int x, int y, const char* text) {
+    const int pixel = STATS_FONT_SCALE;
+    for (; *text; text++, x += 4 * pixel) {
+        const Uint16 glyph = glyph_for(*text);
+        for (int row = 0; row < 5; row++) {
+            const int bits = (glyph >> (3 * (4 - row))) & 07;
+            for (int column = 0; column < 3; column++) {
+                if (!(bits & (4 >> column))) continue;
+                int run = 1;
+                while (column + run < 3 && (bits & (4 >> (column + run)))) run++;
+                push_rect(x + column * pixel, y + row * pixel, run * pixel, pixel);
+                column += run - 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Draws the last frame's counters and the frame time graph in the top-left corner.
+ *
+ * Everything is drawn with SDL_RenderFillRects on the game's renderer: a translucent
+ * panel, the text from a built-in 3x5 pixel font, and one bar per recent frame with a
+ * marker at the 60 Hz budget. Does nothing while the overlay is hidden.
+ *
+ * @param renderer Renderer the frame is being drawn with.
+ */
+void stats_render_overlay(SDL_Renderer* renderer) {
+    if (!overlay_visible) return;
+    enum { MARGIN = 8, PADDING = 6, LINE_HEIGHT = 7 * STATS_FONT_SCALE, MAX_LINES = STAT_COUNT + EVENT_TYPE_COUNT + 2 };
+    char lines[MAX_LINES][64];
+    int length = 0;
+
+    snprintf(lines[length++], sizeof(lines[0]), "frame %.1f ms", (double)last_stats.frame_ms);
+    for (size_t i = 0; i < STAT_COUNT; i++)
+        snprintf(lines[length++], sizeof(lines[0]), "%s %u", stat_labels[i], last_stats.counters[i]);
+    snprintf(lines[length++], sizeof(lines[0]), "events queued/dropped/dispatched");
+    for (size_t i = 0; i < EVENT_TYPE_COUNT; i++) {
+        if (!last_stats.events_queued[i] && !last_stats.events_dropped[i] && !last_stats.events_dispatched[i]) continue;
+        snprintf(lines[length++], sizeof(lines[0]), " %s %u/%u/%u", event_labels[i],
+            last_stats.events_queued[i], last_stats.events_dropped[i], last_stats.events_dispatched[i]);
+    }
+
+    const int graph_width = STATS_GRAPH_LENGTH * 2;
+    int panel_width = graph_width;
+    for (int i = 0; i < length; i++) panel_width = MAX(panel_width, (int)strlen(lines[i]) * 4 * STATS_FONT_SCALE);
+    const int panel_height = PADDING * 3 + length * LINE_HEIGHT + STATS_GRAPH_HEIGHT;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    push_rect(MARGIN, MARGIN, panel_width + 2 * PADDING, panel_height);
+    flush_rects(renderer, 0, 0, 0, 160);
+
+    for (int i = 0; i < length; i++) push_text(MARGIN + PADDING, MARGIN + PADDING + i * LINE_HEIGHT, lines[i]);
+    flush_rects(renderer, 255, 255, 255, 255);
+
+    // Oldest frame on the left; bars over the 60 Hz budget are drawn red
+    const int graph_left = MARGIN + PADDING;
+    const int graph_bottom = MARGIN + panel_height - PADDING;
+    const float budget_ms = 1000.0f / FRAME_PACER_DEFAULT_RATE;
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < STATS_GRAPH_LENGTH; i++) {
+            const float ms = frame_history[(frame_history_next + i) % STATS_GRAPH_LENGTH];
+            if ((ms > budget_ms + 1.0f) != (pass == 1)) continue;
+            const int height = (int)(MIN(ms / STATS_GRAPH_MAX_MS, 1.0f) * STATS_GRAPH_HEIGHT);
+            push_rect(graph_left + (int)i * 2, graph_bottom - height, 2, height);
+        }
+        if (pass == 0) flush_rects(renderer, 80, 220, 80, 255);
+        else flush_rects(renderer, 230, 60, 60, 255);
+    }
+    push_rect(graph_left, graph_bottom - (int)(budget_ms / STATS_GRAPH_MAX_MS * STATS_GRAPH_HEIGHT), graph_width, 1);
+    flush_rects(renderer, 240, 220, 60, 255);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
@@ -0,0 +1,100 @@
+#include "game.h"
+
+/*
+ * Priority and concurrency limit per sound effect. Higher priorities may steal voices
+ * from lower ones; max_voices caps how many copies of one effect play at once.
+ */
+static const VoiceRule voice_rules[AUDIO_COUNT] = {
+    [SFX_COLLISION_BUZZ] = { 2, 2 },
+    [SFX_COLLISION_BEE] = { 2, 2 },
+    [SFX_COLLISION_BAT] = { 2, 2 },
+    [SFX_COLLISION_FLAME] = { 2, 2 },
+    [SFX_COLLISION_PARROT] = { 2, 2 },
+    [SFX_COLLISION_RING] = { 1, 3 },
+    [SFX_COLLISION_LIFE] = { 3, 1 },
+};
+
+static Voice voices[VOICE_CHANNELS];
+static int voice_channels = 0;
+static Uint32 voice_frame = 1;
+static Uint32 voice_serial = 0;
+static int frame_voice[AUDIO_COUNT];
+static Uint32 frame_voice_frame[AUDIO_COUNT];
+
+/**
+ * @brief Starts a chunk on a given channel and records who owns it.
+ */
+static int start_voice(int channel, AudioID id, Mix_Chunk* chunk) {
+    if (Mix_PlayChannel(channel, chunk, 0) < 0) return VOICE_NONE;
+    stats_add(STAT_VOICES_STARTED, 1);
+    voices[channel] = (Voice){ id, voice_rules[id].priority, ++voice_serial, voice_frame };
+    frame_voice[id] = channel;
+    frame_voice_frame[id] = voice_frame;
+    return channel;
+}
+
+/**
+ * @brief Tells whether voice `a` is a better candidate to give up its channel than voice `b`:
+ * lower priority first, then the older one.
+ */
+static bool steal_before(int a, int b) {
+    if (voices[a].priority != voices[b].priority) return voices[a].priority < voices[b].priority;
+    return voices[a].started < voices[b].started;
+}
+
+/**
+ * @brief Allocates the mixer channels the voice manager schedules.
+ *
+ * Must run after Mix_OpenAudio.
+ */
+void voice_initialization(void) {
+    voice_channels = Mix_AllocateChannels(VOICE_CHANNELS);
+    if (voice_channels > VOICE_CHANNELS) voice_channels = VOICE_CHANNELS;
+    memset(voices, 0, sizeof(voices));
+    voice_frame = 1;
+}
+
+/**
+ * @brief Opens a new deduplication window. Call once per frame before events are dispatched.
+ */
+void voice_begin_frame(void) {
+    voice_frame++;
+}
+
+/**
+ * @brief Plays a sound effect on a voice chosen by its priority and concurrency rule.
+ *
+ * Requests for an effect that already started this frame are merged into that voice,
+ * so collecting several rings at once plays the sound once. An effect at its
+ * max_voices limit restarts its oldest voice. Otherwise a free channel is used, and
+ * when every channel is busy the weakest voice of equal or lower priority is stolen.
+ * A request that outranks nothing is dropped.
+ *
+ * @param id AudioID of the sound effect.
+ * @param chunk Chunk to play.
+ * @return The channel playing the effect, or VOICE_NONE if it was dropped.
+ */
+int voice_play(AudioID id, Mix_Chunk* chunk) {
+    if (!chunk || voice_channels <= 0) return VOICE_NONE;
+    if (frame_voice_frame[id] == voice_frame) return frame_voice[id];
+
+    int free_channel = VOICE_NONE, oldest_same = VOICE_NONE, victim = VOICE_NONE;
+    int same_count = 0;
+    for (int channel = 0; channel < voice_channels; channel++) {
+        if (!Mix_Playing(channel)) {
+            if (free_channel == VOICE_NONE) free_channel = channel;
+            continue;
+        }
+        if (voices[channel].id == id) {
+            same_count++;
+            if (oldest_same == VOICE_NONE || voices[channel].started < voices[oldest_same].started) oldest_same = channel;
+        }
+        if (voices[channel].priority <= voice_rules[id].priority && (victim == VOICE_NONE || steal_before(channel, victim)))
+            victim = channel;
+    }
+
+    if (same_count >= voice_rules[id].max_voices && oldest_same != VOICE_NONE) return start_voice(oldest_same, id, chunk);
+    if (free_channel != VOICE_NONE) return start_voice(free_channel, id, chunk);
+    if (victim != VOICE_NONE) return start_voice(victim, id, chunk);
+    return VOICE_NONE;
+}
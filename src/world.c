@@ -0,0 +1,154 @@
+#include "game.h"
+
+/**
+ * @brief Creates the player, the overlay and the entity pools.
+ *
+ * @param world Pointer to the GameWorld to initialize. It must not move afterwards,
+ *        since the pools and the entities they spawn point into it.
+ * @param renderer Renderer the sprites' textures are created with.
+ * @param replay Seed and input source of the session; it must outlive the world.
+ */
+void world_init(GameWorld* world, SDL_Renderer* renderer, Replay* replay) {
+    rng_seed(&world->rng, replay->seed);
+    world->replay = replay;
+    world->sonic = create_sonic(renderer);
+    world->game_over = create_game_over(renderer);
+    sprite_save_previous_position(&world->sonic);
+    sprite_save_previous_position(&world->game_over);
+    entity_store_init(&world->entities, ENTITY_STORE_INITIAL_CAPACITY, &world->rng);
+    // const Sprite ring = create_ring(renderer);
+    // entity_pool_init(&ring_pool, &ring, &world->entities, RING_POOL_CAPACITY, RING_SPAWN_INTERVAL);
+    // const Sprite life = create_life(renderer);
+    // entity_pool_init(&life_pool, &life, &world->entities, LIFE_POOL_CAPACITY, LIFE_SPAWN_INTERVAL);
+    const Sprite buzz = create_buzz_enemy(renderer);
+    entity_pool_init(&world->buzz_pool, &buzz, &world->entities, BUZZ_POOL_CAPACITY, BUZZ_SPAWN_INTERVAL);
+    broadphase_init(&world->broadphase, ENTITY_STORE_INITIAL_CAPACITY);
+    world->pair_handler = NULL;
+    world->pair_context = NULL;
+    world->tick = 0;
+}
+
+/**
+ * @brief Registers the consumer of entity-vs-entity overlaps (e.g., projectiles hitting enemies).
+ *
+ * The broadphase grid is only rebuilt while a handler is registered; the player's own
+ * collisions never need it.
+ *
+ * @param world Pointer to the GameWorld.
+ * @param handler Called with both entity indices for each overlapping pair, or NULL to stop.
+ * @param context Opaque pointer forwarded to the handler.
+ */
+void world_set_pair_handler(GameWorld* world, NarrowphaseCallback handler, void* context) {
+    world->pair_handler = handler;
+    world->pair_context = context;
+}
+
+/**
+ * @brief Advances the simulation by exactly one SIMULATION_TICK_MS step.
+ *
+ * Spawning, animation, motion, collisions and event dispatch all see the same fixed
+ * delta, so the outcome no longer depends on how fast frames are presented.
+ * Collisions against the player are tested in one batched pass through
+ * aabb_overlap_mask(), whose hit bitmask drives the collision state machine. The
+ * broadphase grid is only built when a pair handler is registered.
+ *
+ * @param world Pointer to the GameWorld.
+ * @param live_input Buttons currently held; replaced by the recording during playback.
+ * @return false, without advancing, once a played back session is over.
+ */
+bool world_tick(GameWorld* world, InputState live_input) {
+    InputState input;
+    if (!replay_next_input(world->replay, live_input, &input)) return false;
+    PROFILE_SCOPE("tick");
+
+    sprite_save_previous_position(&world->sonic);
+    sprite_save_previous_position(&world->game_over);
+    entity_store_save_previous_positions(&world->entities);
+
+    {
+        PROFILE_SCOPE("spawn");
+        // entity_pool_update(&ring_pool, SIMULATION_TICK_MS);
+        // entity_pool_update(&life_pool, SIMULATION_TICK_MS);
+        entity_pool_update(&world->buzz_pool, SIMULATION_TICK_MS);
+    }
+    {
+        PROFILE_SCOPE("animation");
+        sprite_animation(&world->sonic, SIMULATION_TICK_MS);
+        stats_add(STAT_SPRITES_ANIMATED, 1);
+        entity_store_animation(&world->entities, SIMULATION_TICK_MS);
+    }
+    {
+        PROFILE_SCOPE("motion");
+        sonic_motion(&world->sonic, input, SIMULATION_TICK_MS);
+        entity_store_motion(&world->entities, SIMULATION_TICK_MS);
+        game_over_motion(&world->game_over, SIMULATION_TICK_MS);
+    }
+    {
+        PROFILE_SCOPE("collisions");
+        entity_store_update_collision_states(&world->entities, &world->sonic);
+        entity_store_handle_collisions(&world->entities, &world->sonic);
+        if (world->pair_handler) {
+            broadphase_clear(&world->broadphase);
+            broadphase_insert_entities(&world->broadphase, &world->entities);
+            broadphase_build(&world->broadphase);
+            broadphase_find_pairs(&world->broadphase);
+            broadphase_narrowphase(&world->broadphase, world->pair_handler, world->pair_context);
+        }
+    }
+    {
+        PROFILE_SCOPE("events");
+        event_listener(&global_queue);
+    }
+    world->tick++;
+    return true;
+}
+
+/**
+ * @brief Records the world's sprites, with their positions at the last two ticks, for the renderer.
+ *
+ * @param world Pointer to the GameWorld.
+ * @param snapshot RenderSnapshot being built for this tick.
+ */
+void world_snapshot(const GameWorld* world, RenderSnapshot* snapshot) {
+    sprite_snapshot(&world->sonic, snapshot, RENDER_LAYER_PLAYER);
+    entity_store_snapshot(&world->entities, snapshot);
+    sprite_snapshot(&world->game_over, snapshot, RENDER_LAYER_OVERLAY);
+}
+
+/**
+ * @brief Frees the pools, the broadphase, the entity store and the sprites' frames.
+ *
+ * @param world Pointer to the GameWorld.
+ */
+void world_free(GameWorld* world) {
+    // entity_pool_free(&ring_pool);
+    // entity_pool_free(&life_pool);
+    entity_pool_free(&world->buzz_pool);
+    broadphase_free(&world->broadphase);
+    entity_store_free(&world->entities);
+    free_sprite_frames(&world->sonic);
+    free_sprite_frames(&world->game_over);
+}
+
+/**
+ * @brief Runs the simulation back to back for a fixed number of ticks, without
+ * rendering, presenting or pacing.
+ *
+ * Every tick opens its own audio frame, as a windowed frame running one tick would.
+ * Without a keyboard the live input is empty, so only a played back session moves
+ * Sonic; the run ends early when that session does.
+ *
+ * @param world Pointer to the GameWorld.
+ * @param ticks Maximum number of ticks to run.
+ * @return Wall time spent, in seconds.
+ */
+double world_run_headless(GameWorld* world, Uint32 ticks) {
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (Uint32 i = 0; i < ticks; i++) {
+        audio_begin_frame();
+        if (!world_tick(world, 0)) break;
+        PROFILE_FRAME_END();
+        stats_end_frame();
+    }
+    return (double)(SDL_GetPerformanceCounter() - start) / (double)SDL_GetPerformanceFrequency();
+}
@@ -0,0 +1,206 @@
+#define _POSIX_C_SOURCE 200809L
+#include "game.h"
+#include <sys/stat.h>
+
+/*
+ * Offline asset baker. Decodes every image and sound the game loads at startup and
+ * writes them into one pack file (see asset_pack.h) that the game maps at runtime:
+ *
+ *     make bake            # writes build/assets.pack
+ *     build/bake_assets [output]
+ */
+
+typedef struct {
+    AssetPackEntry entry;
+    void* payload;
+} BakedAsset;
+
+static BakedAsset* baked_assets = NULL;
+static size_t baked_assets_length = 0;
+static size_t baked_assets_capacity = 0;
+
+/**
+ * @brief Appends an asset to the bake list, taking ownership of its payload.
+ *
+ * The source's modification time and size are recorded so the game can tell when the
+ * baked copy is outdated.
+ */
+static void add_asset(const char* path, AssetPackKind kind, void* payload, size_t size, int width, int height, int pitch) {
+    if (strlen(path) >= ASSET_PACK_PATH_LENGTH) {
+        fprintf(stderr, "Asset path too long for the pack: %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+    struct stat status;
+    if (stat(path, &status) != 0) {
+        fprintf(stderr, "Failed to stat %s.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    if (baked_assets_length == baked_assets_capacity) {
+        baked_assets_capacity = baked_assets_capacity ? baked_assets_capacity * 2 : 64;
+        baked_assets = realloc(baked_assets, sizeof(BakedAsset) * baked_assets_capacity);
+        if (!baked_assets) {
+            fprintf(stderr, "Failed to allocate memory for baked assets.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    BakedAsset* asset = &baked_assets[baked_assets_length++];
+    asset->entry = (AssetPackEntry){0};
+    strcpy(asset->entry.path, path);
+    asset->entry.kind = kind;
+    asset->entry.width = width;
+    asset->entry.height = height;
+    asset->entry.pitch = pitch;
+    asset->entry.size = size;
+    asset->entry.source_mtime = (Sint64)status.st_mtime;
+    asset->entry.source_size = (Uint64)status.st_size;
+    asset->payload = payload;
+}
+
+/**
+ * @brief Decodes an image and stores its pixels, tightly packed, in ASSET_PACK_PIXEL_FORMAT.
+ */
+static void bake_image(const char* path) {
+    SDL_Surface* loaded = IMG_Load(path);
+    if (!loaded) {
+        fprintf(stderr, "Failed to load %s: %s\n", path, IMG_GetError());
+        exit(EXIT_FAILURE);
+    }
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(loaded, ASSET_PACK_PIXEL_FORMAT, 0);
+    SDL_FreeSurface(loaded);
+    if (!converted) {
+        fprintf(stderr, "Failed to convert %s: %s\n", path, SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    const int pitch = converted->w * 4;
+    const size_t size = (size_t)pitch * (size_t)converted->h;
+    Uint8* pixels = malloc(size);
+    if (!pixels) {
+        fprintf(stderr, "Failed to allocate memory for %s pixels.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    for (int row = 0; row < converted->h; row++) {
+        memcpy(pixels + (size_t)row * (size_t)pitch, (Uint8*)converted->pixels + (size_t)row * (size_t)converted->pitch, (size_t)pitch);
+    }
+    add_asset(path, ASSET_PACK_IMAGE, pixels, size, converted->w, converted->h, pitch);
+    SDL_FreeSurface(converted);
+}
+
+/**
+ * @brief Decodes a sound effect to PCM in the mixer's output format.
+ */
+static void bake_sound(const char* path) {
+    Mix_Chunk* chunk = Mix_LoadWAV(path);
+    if (!chunk) {
+        fprintf(stderr, "Failed to load %s: %s\n", path, Mix_GetError());
+        exit(EXIT_FAILURE);
+    }
+    void* samples = malloc(chunk->alen);
+    if (!samples) {
+        fprintf(stderr, "Failed to allocate memory for %s samples.\n", path);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(samples, chunk->abuf, chunk->alen);
+    add_asset(path, ASSET_PACK_SOUND, samples, chunk->alen, 0, 0, 0);
+    Mix_FreeChunk(chunk);
+}
+
+/**
+ * @brief Stores a music file as-is. Stage tracks would be tens of megabytes as PCM,
+ * so they stay compressed and are decoded while streaming.
+ */
+static void bake_music(const char* path) {
+    size_t size = 0;
+    void* bytes = SDL_LoadFile(path, &size);
+    if (!bytes) {
+        fprintf(stderr, "Failed to read %s: %s\n", path, SDL_GetError());
+        exit(EXIT_FAILURE);
+    }
+    add_asset(path, ASSET_PACK_MUSIC, bytes, size, 0, 0, 0);
+}
+
+static int compare_paths(const void* a, const void* b) {
+    return strcmp(((const BakedAsset*)a)->entry.path, ((const BakedAsset*)b)->entry.path);
+}
+
+/**
+ * @brief Sorts the baked assets by path and writes the pack.
+ */
+static void write_pack(const char* output, int frequency, Uint16 format, int channels) {
+    qsort(baked_assets, baked_assets_length, sizeof(BakedAsset), compare_paths);
+    const AssetPackHeader header = {
+        ASSET_PACK_MAGIC, ASSET_PACK_VERSION, (Uint32)baked_assets_length,
+        (Uint32)frequency, format, (Uint16)channels, ASSET_PACK_PIXEL_FORMAT
+    };
+    Uint64 offset = sizeof(AssetPackHeader) + sizeof(AssetPackEntry) * baked_assets_length;
+    for (size_t i = 0; i < baked_assets_length; i++) {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+        baked_assets[i].entry.offset = offset;
+        offset += baked_assets[i].entry.size;
+    }
+
+    FILE* file = fopen(output, "wb");
+    if (!file) {
+        fprintf(stderr, "Failed to open %s for writing.\n", output);
+        exit(EXIT_FAILURE);
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (size_t i = 0; i < baked_assets_length && written; i++)
+        written = fwrite(&baked_assets[i].entry, sizeof(AssetPackEntry), 1, file) == 1;
+    static const Uint8 padding[ASSET_PACK_ALIGNMENT] = {0};
+    for (size_t i = 0; i < baked_assets_length && written; i++) {
+        const long position = ftell(file);
+        written = position >= 0 && (Uint64)position <= baked_assets[i].entry.offset;
+        if (written && baked_assets[i].entry.offset > (Uint64)position)
+            written = fwrite(padding, (size_t)(baked_assets[i].entry.offset - (Uint64)position), 1, file) == 1;
+        if (written && baked_assets[i].entry.size > 0)
+            written = fwrite(baked_assets[i].payload, (size_t)baked_assets[i].entry.size, 1, file) == 1;
+    }
+    if (fclose(file) != 0 || !written) {
+        fprintf(stderr, "Failed to write %s.\n", output);
+        exit(EXIT_FAILURE);
+    }
+    printf("Baked %zu asset(s) into %s (%llu bytes)\n", baked_assets_length, output, (unsigned long long)offset);
+}
+
+int main(int argc, char* argv[]) {
+    const char* output = argc > 1 ? argv[1] : ASSET_PACK_PATH;
+
+    // No device is needed, the mixer is only opened to decode sounds in the game's output format
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+    if (SDL_Init(SDL_INIT_AUDIO) < 0) {
+        fprintf(stderr, "SDL initialization failed: %s\n", SDL_GetError());
+        return EXIT_FAILURE;
+    }
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        fprintf(stderr, "SDL_image initialization failed: %s\n", IMG_GetError());
+        return EXIT_FAILURE;
+    }
+    if (Mix_OpenAudio(AUDIO_FREQUENCY, AUDIO_FORMAT, AUDIO_CHANNELS, AUDIO_CHUNK_SIZE) < 0) {
+        fprintf(stderr, "SDL_mixer initialization failed: %s\n", Mix_GetError());
+        return EXIT_FAILURE;
+    }
+    int frequency = 0, channels = 0;
+    Uint16 format = 0;
+    Mix_QuerySpec(&frequency, &format, &channels);
+
+    bake_image(STAGE_BACKGROUND_PATH);
+    #define SPRITE_ENTRY(path) bake_image(path);
+    #include "sprite_registry.def"
+    #undef SPRITE_ENTRY
+    #define AUDIO_ENTRY(id, path, is_music) if (is_music) bake_music(path); else bake_sound(path);
+    #include "audio_registry.def"
+    #undef AUDIO_ENTRY
+
+    write_pack(output, frequency, format, channels);
+
+    for (size_t i = 0; i < baked_assets_length; i++) {
+        if (baked_assets[i].entry.kind == ASSET_PACK_MUSIC) SDL_free(baked_assets[i].payload);
+        else free(baked_assets[i].payload);
+    }
+    free(baked_assets);
+    Mix_CloseAudio();
+    Mix_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    return EXIT_SUCCESS;
+}
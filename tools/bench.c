@@ -0,0 +1,428 @@
+#include "game.h"
+
+/*
+ * Microbenchmarks for the per-tick hot paths, built without sanitizers:
+ *
+ *     make bench                       # runs every case, writes build/bench.json
+ *     make bench-baseline              # stores the results as the baseline to compare against
+ *     build/bench/bench [--min-ms N] [--json FILE] [--baseline FILE] [--threads N]
+ *
+ * Each case runs at entity (or event) counts from 1 to 100k. An op is one entity
+ * updated or one event processed, so ns/op stays comparable across counts.
+ * The entity_store cases use the job system; --threads 1 measures them single-threaded.
+ * The sprite cases walk a contiguous array of Sprite, so their ns/op follows the size
+ * of the hot Sprite record.
+ * With a baseline, the run fails when any case is more than BENCH_REGRESSION_PERCENT
+ * slower than it.
+ */
+
+#define BENCH_DEFAULT_MIN_MS 200
+#define BENCH_MAX_RESULTS 64
+#define BENCH_NAME_LENGTH 64
+#define BENCH_REGRESSION_PERCENT 10.0
+
+EventQueue global_queue;
+GameOverState game_over_state;
+
+typedef void (*BenchSetup)(size_t count);
+typedef void (*BenchRun)(size_t count);
+
+typedef struct {
+    const char* name;
+    BenchSetup setup;
+    BenchRun run;
+    BenchRun teardown;
+} BenchCase;
+
+typedef struct {
+    char name[BENCH_NAME_LENGTH];
+    size_t count;
+    Uint64 iterations;
+    double ns_per_op;
+    double ops_per_second;
+} BenchResult;
+
+static const size_t bench_counts[] = { 1, 10, 100, 1000, 10000, 100000 };
+
+static Rng bench_rng;
+static int bench_widths[] = { 40, 44 };
+static int bench_heights[] = { 40, 44 };
+static SDL_Texture* bench_textures[2];
+static SDL_Rect bench_sources[2];
+static Sprite bench_archetype;
+static Sprite bench_sonic;
+static Sprite* bench_sprites = NULL;
+static Sprite** bench_sprite_pointers = NULL;
+static RenderSnapshotBuffer bench_snapshots;
+static EntityStore bench_store;
+static Broadphase bench_broadphase;
+static volatile size_t bench_sink = 0;
+
+/**
+ * @brief Builds an enemy-like archetype with two animation frames and null textures.
+ */
+static Sprite make_archetype(void) {
+    Frames frames = {0};
+    frames.length = 2;
+    frames.delay = BUZZ_FRAME_DELAY;
+    frames.widths = bench_widths;
+    frames.heights = bench_heights;
+    frames.texture = bench_textures;
+    frames.sources = bench_sources;
+    return initialize_buzz(frames);
+}
+
+/**
+ * @brief Builds Sonic with one frame and no texture, in the middle of the screen.
+ */
+static Sprite make_sonic(void) {
+    Frames frames = {0};
+    frames.length = 1;
+    frames.widths = bench_widths;
+    frames.heights = bench_heights;
+    Sprite sonic = initialize_sonic(frames);
+    sonic.x = WINDOW_WIDTH / 2;
+    sonic.y = WINDOW_HEIGHT / 2;
+    update_sprite_boundaries(&sonic);
+    return sonic;
+}
+
+static float random_x(void) {
+    return (float)rng_below(&bench_rng, WINDOW_WIDTH);
+}
+
+/**
+ * @brief Fills a contiguous, cache-line aligned array of sprites spread over the
+ * screen, and places Sonic in the middle.
+ */
+static void setup_sprites(size_t count) {
+    bench_archetype = make_archetype();
+    bench_sprites = aligned_alloc(SPRITE_HOT_ALIGNMENT, sizeof(Sprite) * count);
+    bench_sprite_pointers = malloc(sizeof(Sprite*) * count);
+    if (!bench_sprites || !bench_sprite_pointers) {
+        fprintf(stderr, "Failed to allocate memory for the benchmark sprites.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        bench_sprites[i] = bench_archetype;
+        bench_sprites[i].x = random_x();
+        bench_sprites[i].y = (float)get_random_y_position(&bench_rng, &bench_archetype);
+        bench_sprites[i].animation_accumulator = rng_below(&bench_rng, BUZZ_FRAME_DELAY);
+        update_sprite_boundaries(&bench_sprites[i]);
+        bench_sprite_pointers[i] = &bench_sprites[i];
+    }
+    bench_sonic = make_sonic();
+    render_snapshot_buffer_init(&bench_snapshots);
+}
+
+static void teardown_sprites(size_t count) {
+    (void)count;
+    render_snapshot_buffer_free(&bench_snapshots);
+    free(bench_sprite_pointers);
+    free(bench_sprites);
+    bench_sprite_pointers = NULL;
+    bench_sprites = NULL;
+    free_sprite_frames(&bench_archetype);
+    free_sprite_frames(&bench_sonic);
+}
+
+static void run_sprite_animation(size_t count) {
+    for (size_t i = 0; i < count; i++) sprite_animation(&bench_sprites[i], SIMULATION_TICK_MS);
+    stats_add(STAT_SPRITES_ANIMATED, (unsigned)count);
+}
+
+static void run_sprite_motion(size_t count) {
+    for (size_t i = 0; i < count; i++) sprite_motion(&bench_sprites[i], &bench_rng, SIMULATION_TICK_MS);
+}
+
+static void run_sprite_collisions(size_t count) {
+    update_collision_states(&bench_sonic, bench_sprite_pointers, count);
+}
+
+static void run_sprite_snapshot(size_t count) {
+    RenderSnapshot* snapshot = render_snapshot_begin(&bench_snapshots);
+    for (size_t i = 0; i < count; i++) sprite_snapshot(&bench_sprites[i], snapshot, RENDER_LAYER_ENTITIES);
+    render_snapshot_publish(&bench_snapshots, 0, 0);
+}
+
+/**
+ * @brief Fills a store with entities spread over the screen, and places Sonic in the middle.
+ */
+static void setup_store(size_t count) {
+    bench_archetype = make_archetype();
+    entity_store_init(&bench_store, count, &bench_rng);
+    for (size_t i = 0; i < count; i++) {
+        const size_t index = entity_store_add(&bench_store, &bench_archetype);
+        bench_store.x[index] = random_x();
+        entity_store_update_boundaries(&bench_store, index);
+    }
+    bench_sonic = make_sonic();
+}
+
+static void teardown_store(size_t count) {
+    (void)count;
+    entity_store_free(&bench_store);
+    free_sprite_frames(&bench_archetype);
+    free_sprite_frames(&bench_sonic);
+    while (!is_queue_empty(&global_queue)) dequeue_event(&global_queue);
+}
+
+static void run_entity_store_animation(size_t count) {
+    (void)count;
+    entity_store_animation(&bench_store, SIMULATION_TICK_MS);
+}
+
+static void run_entity_store_motion(size_t count) {
+    (void)count;
+    entity_store_motion(&bench_store, SIMULATION_TICK_MS);
+}
+
+/**
+ * @brief Linear collision pass: every entity is tested against Sonic. The events it emits are drained
+ * without being dispatched, so Sonic never dies and the next pass sees the same world.
+ */
+static void run_collisions(size_t count) {
+    (void)count;
+    entity_store_update_collision_states(&bench_store, &bench_sonic);
+    entity_store_handle_collisions(&bench_store, &bench_sonic);
+    while (!is_queue_empty(&global_queue)) dequeue_event(&global_queue);
+}
+
+static void setup_broadphase(size_t count) {
+    setup_store(count);
+    broadphase_init(&bench_broadphase, count);
+}
+
+static void teardown_broadphase(size_t count) {
+    broadphase_free(&bench_broadphase);
+    teardown_store(count);
+}
+
+static void count_pair(Uint32 id_a, Uint32 id_b, void* context) {
+    (void)id_a;
+    (void)id_b;
+    (*(size_t*)context)++;
+}
+
+/**
+ * @brief Pair pass as world_tick() runs it once a pair handler is registered:
+ * rebuild the grid from the store, then collect and test the candidate pairs.
+ */
+static void run_broadphase_pairs(size_t count) {
+    (void)count;
+    size_t pairs = 0;
+    broadphase_clear(&bench_broadphase);
+    broadphase_insert_entities(&bench_broadphase, &bench_store);
+    broadphase_build(&bench_broadphase);
+    broadphase_find_pairs(&bench_broadphase);
+    broadphase_narrowphase(&bench_broadphase, count_pair, &pairs);
+    bench_sink += pairs;
+}
+
+static void setup_nothing(size_t count) {
+    (void)count;
+}
+
+static void run_queue_roundtrip(size_t count) {
+    GameEvent event = { .type = EVENT_SCREEN_SHAKE };
+    for (size_t i = 0; i < count; i++) queue_event(&global_queue, event);
+    size_t sink = 0;
+    for (size_t i = 0; i < count; i++) sink += (size_t)dequeue_event(&global_queue).type;
+    bench_sink += sink;
+}
+
+/**
+ * @brief A frame's worth of gameplay events: ring pickups, life
+ * gains and sound effects, which event_listener() coalesces and dispatches.
+ */
+static void run_event_listener(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        GameEvent event = {0};
+        switch (i % 4) {
+            case 0:
+            case 1:
+                event.type = EVENT_RINGS_CHANGED;
+                event.payload.collision.target = &bench_sonic;
+                event.payload.collision.delta = 1;
+                break;
+            case 2:
+                event.type = EVENT_LIFE_CHANGED;
+                event.payload.collision.target = &bench_sonic;
+                event.payload.collision.delta = 1;
+                break;
+            default:
+                event.type = EVENT_SOUND_EFFECT;
+                event.payload.sfx.id = SFX_COLLISION_RING;
+                break;
+        }
+        queue_event(&global_queue, event);
+    }
+    event_listener(&global_queue);
+}
+
+static void setup_listener(size_t count) {
+    (void)count;
+    bench_sonic = make_sonic();
+}
+
+static void teardown_listener(size_t count) {
+    (void)count;
+    free_sprite_frames(&bench_sonic);
+}
+
+static const BenchCase bench_cases[] = {
+    { "sprite_animation", setup_sprites, run_sprite_animation, teardown_sprites },
+    { "sprite_motion", setup_sprites, run_sprite_motion, teardown_sprites },
+    { "sprite_collisions", setup_sprites, run_sprite_collisions, teardown_sprites },
+    { "sprite_snapshot", setup_sprites, run_sprite_snapshot, teardown_sprites },
+    { "entity_store_animation", setup_store, run_entity_store_animation, teardown_store },
+    { "entity_store_motion", setup_store, run_entity_store_motion, teardown_store },
+    { "collisions", setup_store, run_collisions, teardown_store },
+    { "broadphase_pairs", setup_broadphase, run_broadphase_pairs, teardown_broadphase },
+    { "queue_dequeue_event", setup_nothing, run_queue_roundtrip, setup_nothing },
+    { "event_listener", setup_listener, run_event_listener, teardown_listener },
+};
+
+static double elapsed_ms(Uint64 start) {
+    return (double)(SDL_GetPerformanceCounter() - start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+/**
+ * @brief Times one case at one count, doubling the iterations until a run lasts at least min_ms.
+ */
+static BenchResult measure(const BenchCase* bench, size_t count, double min_ms) {
+    bench->setup(count);
+    bench->run(count); // Warm up caches and let the buffers reach their steady size
+    Uint64 iterations = 1;
+    double ms = 0.0;
+    for (;;) {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        for (Uint64 i = 0; i < iterations; i++) bench->run(count);
+        ms = elapsed_ms(start);
+        if (ms >= min_ms || iterations >= (1ull << 40)) break;
+        iterations *= 2;
+    }
+    bench->teardown(count);
+
+    BenchResult result = {0};
+    snprintf(result.name, sizeof(result.name), "%s", bench->name);
+    result.count = count;
+    result.iterations = iterations;
+    const double ops = (double)iterations * (double)count;
+    result.ns_per_op = ms * 1e6 / ops;
+    result.ops_per_second = ops / (ms / 1000.0);
+    return result;
+}
+
+/**
+ * @brief Writes the results as JSON, one result object per line.
+ */
+static bool write_json(const char* path, const BenchResult* results, size_t length) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "Failed to create %s\n", path);
+        return false;
+    }
+    fprintf(file, "{\n  \"results\": [\n");
+    for (size_t i = 0; i < length; i++) {
+        fprintf(file, "    {\"name\": \"%s\", \"count\": %zu, \"iterations\": %llu, \"ns_per_op\": %.4f, \"ops_per_second\": %.1f}%s\n",
+            results[i].name, results[i].count, (unsigned long long)results[i].iterations,
+            results[i].ns_per_op, results[i].ops_per_second, i + 1 < length ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Reads a file written by write_json(). Lines that are not result objects are skipped.
+ */
+static size_t read_json(const char* path, BenchResult* results, size_t capacity) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Failed to open baseline %s\n", path);
+        return 0;
+    }
+    char line[512];
+    size_t length = 0;
+    while (length < capacity && fgets(line, sizeof(line), file)) {
+        BenchResult* result = &results[length];
+        unsigned long long iterations = 0;
+        if (sscanf(line, " {\"name\": \"%63[^\"]\", \"count\": %zu, \"iterations\": %llu, \"ns_per_op\": %lf, \"ops_per_second\": %lf}",
+                result->name, &result->count, &iterations, &result->ns_per_op, &result->ops_per_second) == 5) {
+            result->iterations = iterations;
+            length++;
+        }
+    }
+    fclose(file);
+    return length;
+}
+
+/**
+ * @brief Prints every case next to its baseline and counts the ones that got slower.
+ */
+static size_t compare_baseline(const BenchResult* results, size_t length, const BenchResult* baseline, size_t baseline_length) {
+    size_t regressions = 0;
+    printf("\n%-24s %8s %12s %12s %9s\n", "case", "count", "base ns/op", "ns/op", "change");
+    for (size_t i = 0; i < length; i++) {
+        for (size_t j = 0; j < baseline_length; j++) {
+            if (strcmp(results[i].name, baseline[j].name) != 0 || results[i].count != baseline[j].count) continue;
+            const double change = (results[i].ns_per_op / baseline[j].ns_per_op - 1.0) * 100.0;
+            const bool slower = change > BENCH_REGRESSION_PERCENT;
+            if (slower) regressions++;
+            printf("%-24s %8zu %12.2f %12.2f %+8.1f%%%s\n", results[i].name, results[i].count,
+                baseline[j].ns_per_op, results[i].ns_per_op, change, slower ? "  SLOWER" : "");
+            break;
+        }
+    }
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    double min_ms = BENCH_DEFAULT_MIN_MS;
+    const char* json_path = NULL;
+    const char* baseline_path = NULL;
+    int threads = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) min_ms = atof(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) json_path = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "Usage: %s [--min-ms N] [--json FILE] [--baseline FILE] [--threads N]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    rng_seed(&bench_rng, 1);
+    initialize_event_queue();
+    // --threads 1 keeps every pass on this thread; 0 uses one thread per core
+    if (threads != 1) jobs_start(threads - 1);
+    printf("Threads: %d\n", jobs_worker_count() + 1);
+    printf("Collision kernel: %s\n", aabb_kernel_name());
+    printf("Sprite: %zu bytes hot, %zu bytes of components shared by its copies\n", sizeof(Sprite), sizeof(SpriteComponents));
+
+    static BenchResult results[BENCH_MAX_RESULTS];
+    size_t results_length = 0;
+    printf("%-24s %8s %12s %10s %14s\n", "case", "count", "iterations", "ns/op", "ops/s");
+    for (size_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        for (size_t n = 0; n < sizeof(bench_counts) / sizeof(bench_counts[0]); n++) {
+            const BenchResult result = measure(&bench_cases[c], bench_counts[n], min_ms);
+            printf("%-24s %8zu %12llu %10.2f %14.0f\n", result.name, result.count,
+                (unsigned long long)result.iterations, result.ns_per_op, result.ops_per_second);
+            if (results_length < BENCH_MAX_RESULTS) results[results_length++] = result;
+        }
+    }
+
+    int status = EXIT_SUCCESS;
+    if (json_path && !write_json(json_path, results, results_length)) status = EXIT_FAILURE;
+    if (baseline_path) {
+        static BenchResult baseline[BENCH_MAX_RESULTS];
+        const size_t baseline_length = read_json(baseline_path, baseline, BENCH_MAX_RESULTS);
+        const size_t regressions = compare_baseline(results, results_length, baseline, baseline_length);
+        printf("%zu case(s) more than %.0f%% slower than %s\n", regressions, BENCH_REGRESSION_PERCENT, baseline_path);
+        if (regressions > 0) status = EXIT_FAILURE;
+    }
+    jobs_stop();
+    event_queue_free(&global_queue);
+    return status;
+}